@@ -0,0 +1,387 @@
+#include "adaptativos.h"
+#include <stdlib.h>
+
+// Listas de cada algoritmo (0 a 3 usam as ligações [0], 4 e 5 as ligações [1])
+#define ARC_T1   0 // Residentes vistos uma vez
+#define ARC_B1   1 // Fantasmas que saíram de T1
+#define ARC_T2   2 // Residentes vistos ao menos duas vezes
+#define ARC_B2   3 // Fantasmas que saíram de T2
+#define Q2_A1IN  0 // Residentes vistos uma vez (FIFO)
+#define Q2_A1OUT 1 // Fantasmas que saíram de A1in (FIFO)
+#define Q2_AM    2 // Residentes reutilizados (LRU)
+#define LIRS_S   0 // Pilha de recência: LIR, HIR residentes e HIR fantasmas
+#define LIRS_Q   4 // HIR residentes, vítima na cauda
+#define LIRS_N   5 // HIR fantasmas ainda na pilha, do mais novo ao mais antigo
+
+#define LIGACAO(lista) ((lista) >= LIRS_Q)
+
+// Retira o nó da lista em que está no conjunto de ligações indicado
+static void retira(EstadoAdaptativo *est, int no, int ligacao) {
+    NoAdaptativo *n = &est->nos[no];
+    if (n->lista[ligacao] < 0)
+        return;
+    ListaAdaptativa *l = &est->listas[n->lista[ligacao]];
+    if (n->ant[ligacao] != -1)
+        est->nos[n->ant[ligacao]].prox[ligacao] = n->prox[ligacao];
+    else
+        l->cabeca = n->prox[ligacao];
+    if (n->prox[ligacao] != -1)
+        est->nos[n->prox[ligacao]].ant[ligacao] = n->ant[ligacao];
+    else
+        l->cauda = n->ant[ligacao];
+    l->tamanho--;
+    n->lista[ligacao] = -1;
+    n->ant[ligacao] = n->prox[ligacao] = -1;
+}
+
+// Move o nó para a cabeça (mais recente) da lista
+static void insereCabeca(EstadoAdaptativo *est, int lista, int no) {
+    int ligacao = LIGACAO(lista);
+    retira(est, no, ligacao);
+    NoAdaptativo *n = &est->nos[no];
+    ListaAdaptativa *l = &est->listas[lista];
+    n->lista[ligacao] = lista;
+    n->ant[ligacao] = -1;
+    n->prox[ligacao] = l->cabeca;
+    if (l->cabeca != -1)
+        est->nos[l->cabeca].ant[ligacao] = no;
+    else
+        l->cauda = no;
+    l->cabeca = no;
+    l->tamanho++;
+}
+
+// Retira um nó do pool e o registra no índice; -1 se o pool acabou
+static int novoNo(EstadoAdaptativo *est, uint64_t chave) {
+    int no = est->livre;
+    if (no == -1 || mapaInsere(&est->indice, chave, no) != 0)
+        return -1;
+    est->livre = est->nos[no].prox[0];
+    NoAdaptativo *n = &est->nos[no];
+    n->chave = chave;
+    n->frame = -1;
+    n->lir = 0;
+    for (int k = 0; k < 2; k++)
+        n->lista[k] = n->ant[k] = n->prox[k] = -1;
+    return no;
+}
+
+// Esquece o nó: sai das listas e do índice e volta para o pool
+static void apagaNo(EstadoAdaptativo *est, int no) {
+    retira(est, no, 0);
+    retira(est, no, 1);
+    mapaRemove(&est->indice, est->nos[no].chave);
+    est->nos[no].prox[0] = est->livre;
+    est->livre = no;
+}
+
+// Nó da página no índice; -1 se ela não é residente nem fantasma
+static int buscaNo(const EstadoAdaptativo *est, uint64_t chave) {
+    int64_t no;
+    return mapaBusca(&est->indice, chave, &no) ? (int)no : -1;
+}
+
+// Tira o nó residente do frame, deixando-o como fantasma; retorna o frame
+static int desocupa(EstadoAdaptativo *est, int no) {
+    int frame = est->nos[no].frame;
+    est->no_do_frame[frame] = -1;
+    est->nos[no].frame = -1;
+    return frame;
+}
+
+// Indica se o algoritmo usa o estado adaptativo
+int ehAdaptativo(int algoritmo) {
+    return algoritmo == ALG_ARC || algoritmo == ALG_2Q || algoritmo == ALG_LIRS;
+}
+
+// Aloca o estado no primeiro uso (quem só usa FIFO/LRU não paga a memória)
+int preparaAdaptativo(MemoriaFisica *mem) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    if (est->nos)
+        return 0;
+    // Residentes + no máximo num_frames fantasmas em qualquer dos algoritmos
+    est->capacidade = 2 * mem->num_frames + 2;
+    est->nos = malloc(est->capacidade * sizeof(NoAdaptativo));
+    est->no_do_frame = malloc(mem->num_frames * sizeof(int));
+    if (!est->nos || !est->no_do_frame ||
+        mapaInicializa(&est->indice, 2 * est->capacidade) != 0) {
+        free(est->nos);
+        free(est->no_do_frame);
+        est->nos = NULL;
+        est->no_do_frame = NULL;
+        return -1;
+    }
+    reiniciaAdaptativo(mem);
+    return 0;
+}
+
+// Esvazia listas e índice e recalcula os parâmetros para o número de frames
+void reiniciaAdaptativo(MemoriaFisica *mem) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    if (!est->nos)
+        return;
+    for (int i = 0; i < est->capacidade; i++)
+        est->nos[i].prox[0] = (i + 1 < est->capacidade) ? i + 1 : -1;
+    est->livre = 0;
+    for (int f = 0; f < mem->num_frames; f++)
+        est->no_do_frame[f] = -1;
+    for (int l = 0; l < NUM_LISTAS_ADAPTATIVAS; l++) {
+        est->listas[l].cabeca = est->listas[l].cauda = -1;
+        est->listas[l].tamanho = 0;
+    }
+    mapaLimpa(&est->indice);
+
+    int c = mem->num_frames;
+    est->p = 0;
+    // 2Q: A1in com 25% dos frames e A1out com fantasmas de 50% (valores do artigo)
+    est->k_in = c / 4 > 0 ? c / 4 : 1;
+    est->k_out = c / 2 > 0 ? c / 2 : 1;
+    // LIRS: 1% dos frames (ao menos um) para os HIR residentes
+    est->max_lir = c - (c / 100 > 0 ? c / 100 : 1);
+    est->num_lir = 0;
+    est->max_fantasmas = c;
+}
+
+// Libera o estado adaptativo
+void liberaAdaptativo(MemoriaFisica *mem) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    if (est->nos)
+        mapaLibera(&est->indice);
+    free(est->nos);
+    free(est->no_do_frame);
+    est->nos = NULL;
+    est->no_do_frame = NULL;
+}
+
+// Vítima residente da lista: a cauda ou, com janela > 0, a página limpa mais
+// antiga entre as janela últimas (a modificada custaria uma gravação no disco)
+static int vitimaDaLista(const MemoriaFisica *mem, int lista, int janela) {
+    const EstadoAdaptativo *est = &mem->adaptativo;
+    int ligacao = LIGACAO(lista);
+    int cauda = est->listas[lista].cauda;
+    for (int no = cauda, k = 0; no != -1 && k < janela; no = est->nos[no].ant[ligacao], k++) {
+        const Pagina *pag = mem->frames[est->nos[no].frame].entrada;
+        if (pag && !(*pag & PAG_MODIFICADA))
+            return no;
+    }
+    return cauda;
+}
+
+// ARC: REPLACE do artigo; a vítima vira fantasma em B1 ou B2
+static int substituiARC(MemoriaFisica *mem, int chave_em_b2, int janela) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    int t1 = est->listas[ARC_T1].tamanho;
+    int de_t1 = t1 > 0 && (t1 > est->p || (chave_em_b2 && t1 == est->p));
+    if (est->listas[ARC_T2].tamanho == 0)
+        de_t1 = 1;
+    int vitima = vitimaDaLista(mem, de_t1 ? ARC_T1 : ARC_T2, janela);
+    insereCabeca(est, de_t1 ? ARC_B1 : ARC_B2, vitima);
+    return desocupa(est, vitima);
+}
+
+// ARC: ajusta p pelos fantasmas e escolhe a vítima (frame_livre >= 0 dispensa vítima)
+static int faltaARC(MemoriaFisica *mem, uint64_t chave, int frame_livre, int janela) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    ListaAdaptativa *l = est->listas;
+    int c = mem->num_frames;
+    int frame = frame_livre;
+    int no = buscaNo(est, chave);
+    int destino = ARC_T2;
+
+    if (no >= 0 && est->nos[no].lista[0] == ARC_B1) {
+        // Fantasma de T1: a recência merece mais espaço
+        int delta = l[ARC_B1].tamanho >= l[ARC_B2].tamanho ? 1 : l[ARC_B2].tamanho / l[ARC_B1].tamanho;
+        est->p = (est->p + delta < c) ? est->p + delta : c;
+        if (frame < 0)
+            frame = substituiARC(mem, 0, janela);
+    } else if (no >= 0) {
+        // Fantasma de T2: a frequência merece mais espaço
+        int delta = l[ARC_B2].tamanho >= l[ARC_B1].tamanho ? 1 : l[ARC_B1].tamanho / l[ARC_B2].tamanho;
+        est->p = (est->p - delta > 0) ? est->p - delta : 0;
+        if (frame < 0)
+            frame = substituiARC(mem, 1, janela);
+    } else {
+        int total = l[ARC_T1].tamanho + l[ARC_T2].tamanho + l[ARC_B1].tamanho + l[ARC_B2].tamanho;
+        if (l[ARC_T1].tamanho + l[ARC_B1].tamanho >= c) {
+            if (l[ARC_B1].tamanho > 0) {
+                apagaNo(est, l[ARC_B1].cauda);
+                if (frame < 0)
+                    frame = substituiARC(mem, 0, janela);
+            } else if (frame < 0) {
+                // T1 ocupa toda a memória: a vítima sai sem virar fantasma
+                int vitima = vitimaDaLista(mem, ARC_T1, janela);
+                frame = desocupa(est, vitima);
+                apagaNo(est, vitima);
+            }
+        } else if (total >= c) {
+            if (total >= 2 * c && l[ARC_B2].tamanho > 0)
+                apagaNo(est, l[ARC_B2].cauda);
+            if (frame < 0)
+                frame = substituiARC(mem, 0, janela);
+        }
+        destino = ARC_T1;
+        no = novoNo(est, chave);
+    }
+    if (no < 0)
+        return -1;
+    insereCabeca(est, destino, no);
+    est->nos[no].frame = frame;
+    est->no_do_frame[frame] = no;
+    return frame;
+}
+
+// 2Q: vítima sai de A1in (virando fantasma em A1out) se A1in passou do limite, senão de Am
+static int falta2Q(MemoriaFisica *mem, uint64_t chave, int frame_livre, int janela) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    ListaAdaptativa *l = est->listas;
+    int frame = frame_livre;
+    if (frame < 0) {
+        if (l[Q2_A1IN].tamanho > est->k_in || l[Q2_AM].tamanho == 0) {
+            int vitima = vitimaDaLista(mem, Q2_A1IN, janela);
+            frame = desocupa(est, vitima);
+            insereCabeca(est, Q2_A1OUT, vitima);
+            if (l[Q2_A1OUT].tamanho > est->k_out)
+                apagaNo(est, l[Q2_A1OUT].cauda);
+        } else {
+            int vitima = vitimaDaLista(mem, Q2_AM, janela);
+            frame = desocupa(est, vitima);
+            apagaNo(est, vitima);
+        }
+    }
+
+    // Página lembrada em A1out foi reutilizada: vai direto para Am
+    int no = buscaNo(est, chave);
+    int destino = Q2_AM;
+    if (no < 0) {
+        no = novoNo(est, chave);
+        destino = Q2_A1IN;
+        if (no < 0)
+            return -1;
+    }
+    insereCabeca(est, destino, no);
+    est->nos[no].frame = frame;
+    est->no_do_frame[frame] = no;
+    return frame;
+}
+
+// LIRS: remove do fundo da pilha tudo que não é LIR (fantasmas são esquecidos)
+static void podaPilha(EstadoAdaptativo *est) {
+    int fundo;
+    while ((fundo = est->listas[LIRS_S].cauda) != -1 && !est->nos[fundo].lir) {
+        retira(est, fundo, 0);
+        if (est->nos[fundo].frame < 0)
+            apagaNo(est, fundo);
+    }
+}
+
+// LIRS: o LIR do fundo da pilha vira HIR residente no fim da fila Q
+static void rebaixaFundo(EstadoAdaptativo *est) {
+    podaPilha(est); // Sem LIR algum, HIR novos podem estar no fundo
+    int fundo = est->listas[LIRS_S].cauda;
+    est->nos[fundo].lir = 0;
+    est->num_lir--;
+    retira(est, fundo, 0);
+    insereCabeca(est, LIRS_Q, fundo);
+    podaPilha(est);
+}
+
+// LIRS: vítima é o HIR residente mais antigo de Q; se ainda estiver na pilha, vira fantasma
+static int faltaLIRS(MemoriaFisica *mem, uint64_t chave, int frame_livre, int janela) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    ListaAdaptativa *l = est->listas;
+    int frame = frame_livre;
+    if (frame < 0) {
+        // Com a memória cheia há ao menos c - max_lir HIR residentes, então Q não está vazia
+        int vitima = vitimaDaLista(mem, LIRS_Q, janela);
+        frame = desocupa(est, vitima);
+        retira(est, vitima, 1);
+        if (est->nos[vitima].lista[0] == LIRS_S) {
+            insereCabeca(est, LIRS_N, vitima);
+            if (l[LIRS_N].tamanho > est->max_fantasmas)
+                apagaNo(est, l[LIRS_N].cauda);
+        } else {
+            apagaNo(est, vitima);
+        }
+    }
+
+    int no = buscaNo(est, chave);
+    if (est->num_lir < est->max_lir || no >= 0) {
+        // Aquecimento, ou fantasma ainda na pilha (IRR menor que a recência do fundo)
+        if (no < 0 && (no = novoNo(est, chave)) < 0)
+            return -1;
+        retira(est, no, 1);
+        est->nos[no].lir = 1;
+        est->num_lir++;
+        insereCabeca(est, LIRS_S, no);
+        if (est->num_lir > est->max_lir)
+            rebaixaFundo(est);
+    } else {
+        if ((no = novoNo(est, chave)) < 0)
+            return -1;
+        insereCabeca(est, LIRS_S, no);
+        insereCabeca(est, LIRS_Q, no);
+    }
+    est->nos[no].frame = frame;
+    est->no_do_frame[frame] = no;
+    return frame;
+}
+
+// Trata a falta da página: usa frame_livre (se >= 0) ou escolhe a vítima, preferindo
+// páginas limpas entre as janela candidatas; retorna o frame da página (-1 se
+// faltou memória para o histórico)
+int faltaAdaptativa(MemoriaFisica *mem, int algoritmo, uint64_t chave, int frame_livre,
+                    int janela) {
+    mem->adaptativo.algoritmo = algoritmo;
+    switch (algoritmo) {
+        case ALG_ARC: return faltaARC(mem, chave, frame_livre, janela);
+        case ALG_2Q:  return falta2Q(mem, chave, frame_livre, janela);
+        default:      return faltaLIRS(mem, chave, frame_livre, janela);
+    }
+}
+
+// Atualiza as listas em um hit, em O(1)
+void hitAdaptativo(MemoriaFisica *mem, int algoritmo, int frame) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    int no = est->no_do_frame[frame];
+    NoAdaptativo *n = &est->nos[no];
+    switch (algoritmo) {
+        case ALG_ARC:
+            insereCabeca(est, ARC_T2, no);
+            break;
+        case ALG_2Q:
+            // Em A1in o hit não muda nada (correlacionado com a primeira referência)
+            if (n->lista[0] == Q2_AM)
+                insereCabeca(est, Q2_AM, no);
+            break;
+        default:
+            if (n->lir) {
+                insereCabeca(est, LIRS_S, no);
+                podaPilha(est);
+            } else if (n->lista[0] == LIRS_S) {
+                // HIR com IRR pequeno: vira LIR e o LIR do fundo vira HIR
+                retira(est, no, 1);
+                n->lir = 1;
+                est->num_lir++;
+                insereCabeca(est, LIRS_S, no);
+                rebaixaFundo(est);
+            } else {
+                insereCabeca(est, LIRS_S, no);
+                insereCabeca(est, LIRS_Q, no);
+            }
+            break;
+    }
+}
+
+// Esquece a página do frame liberado (processo removido)
+void liberaFrameAdaptativo(MemoriaFisica *mem, int frame) {
+    EstadoAdaptativo *est = &mem->adaptativo;
+    if (!est->nos || est->no_do_frame[frame] < 0)
+        return;
+    int no = est->no_do_frame[frame];
+    if (est->nos[no].lir)
+        est->num_lir--;
+    desocupa(est, no);
+    apagaNo(est, no);
+    if (est->algoritmo == ALG_LIRS)
+        podaPilha(est);
+}
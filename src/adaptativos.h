@@ -0,0 +1,16 @@
+#ifndef ADAPTATIVOS_H
+#define ADAPTATIVOS_H
+
+#include "estruturas.h"
+
+// ARC, 2Q e LIRS: listas de páginas residentes e fantasmas com operações O(1)
+int ehAdaptativo(int algoritmo);
+int preparaAdaptativo(MemoriaFisica *mem);
+void reiniciaAdaptativo(MemoriaFisica *mem);
+void liberaAdaptativo(MemoriaFisica *mem);
+int faltaAdaptativa(MemoriaFisica *mem, int algoritmo, uint64_t chave, int frame_livre,
+                    int janela);
+void hitAdaptativo(MemoriaFisica *mem, int algoritmo, int frame);
+void liberaFrameAdaptativo(MemoriaFisica *mem, int frame);
+
+#endif
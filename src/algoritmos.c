@@ -1,46 +1,49 @@
 #include "algoritmos.h"
+#include "adaptativos.h"
+#include "alocacao.h"
+#include "antecipacao.h"
+#include "estatisticas.h"
+#include "otimo.h"
+#include "paginas_grandes.h"
+#include "comprimida.h"
+#include "instrumentacao.h"
+#include "tabela_paginas.h"
+#include "tlb.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// Localiza processo pelo pid (via índice hash)
+Processo *buscaProcesso(const Simulador *sim, int pid) {
+    int64_t indice;
+    if (!mapaBusca(&sim->indice_processos, (uint32_t)pid, &indice))
+        return NULL;
+    return &sim->processos[indice];
+}
+
+// Retorna a entrada da página carregada no frame (NULL se livre)
+static Pagina *paginaDoFrame(const Simulador *sim, int frame) {
+    return sim->memoria.frames[frame].entrada;
+}
 
 // Imprime estado atual da memória física
 static void imprimeEstadoMemoria(const Simulador *sim) {
-    printf("Tempo t=%d\n", sim->tempo_atual);
+    printf("Tempo t=%lld\n", (long long)sim->tempo_atual);
     printf("Estado da Memoria Fisica:\n");
     // Desenha borda superior
     for (int i = 0; i < sim->memoria.num_frames; i++)
         printf(" ------- ");
     printf("\n");
 
-    // Conteúdo dos frames
+    // Conteúdo dos frames (lido direto da tabela invertida)
     for (int i = 0; i < sim->memoria.num_frames; i++) {
-        int pid = sim->memoria.frames[i];
-        if (pid == -1) {
+        const EntradaFrame *ef = &sim->memoria.frames[i];
+        if (ef->pid == -1) {
             printf("|  ----  "); // Frame livre
         } else {
-            int page_num = -1;
-            Processo *proc = NULL;
-            // Busca processo dono do frame
-            for (int j = 0; j < sim->num_processos; j++) {
-                if (sim->processos[j].pid == pid) {
-                    proc = &sim->processos[j];
-                    break;
-                }
-            }
-            // Busca página no frame
-            if (proc) {
-                for (int p = 0; p < proc->num_paginas; p++) {
-                    Pagina *pg = &proc->tabela_paginas[p];
-                    if (pg->presente && pg->frame == i) {
-                        page_num = p;
-                        break;
-                    }
-                }
-            }
             // Formata saída (ex: P1-3 = Processo 1, página 3)
-            if (page_num >= 0)
-                printf("| P%d-%d   ", pid, page_num);
-            else
-                printf("| ????   "); // Erro (não deveria ocorrer)
+            printf("| P%d-%lld   ", ef->pid, (long long)ef->pagina);
         }
     }
     printf("|\n");
@@ -51,230 +54,1154 @@ static void imprimeEstadoMemoria(const Simulador *sim) {
     printf("\n\n");
 }
 
+// Remove frame da lista de recência do LRU
+static void lruRemove(MemoriaFisica *mem, int frame) {
+    EntradaFrame *ef = &mem->frames[frame];
+    if (ef->ant != -1)
+        mem->frames[ef->ant].prox = ef->prox;
+    else
+        mem->lru_cabeca = ef->prox;
+    if (ef->prox != -1)
+        mem->frames[ef->prox].ant = ef->ant;
+    else
+        mem->lru_cauda = ef->ant;
+    ef->ant = ef->prox = -1;
+}
+
+// Insere frame na cabeça da lista de recência (mais recente)
+static void lruInsereCabeca(MemoriaFisica *mem, int frame) {
+    EntradaFrame *ef = &mem->frames[frame];
+    ef->ant = -1;
+    ef->prox = mem->lru_cabeca;
+    if (mem->lru_cabeca != -1)
+        mem->frames[mem->lru_cabeca].ant = frame;
+    else
+        mem->lru_cauda = frame;
+    mem->lru_cabeca = frame;
+}
+
+// Insere frame no final da fila circular do FIFO
+static void fifoInsere(MemoriaFisica *mem, int frame) {
+    int pos = (mem->fifo_inicio + mem->fifo_tamanho) % mem->num_frames;
+    mem->fila_fifo[pos] = frame;
+    mem->fifo_tamanho++;
+}
+
+// Retira o frame da posição k da fila do FIFO (0 é o carregado há mais tempo),
+// fechando o buraco com as k anteriores
+static int fifoRetiraPosicao(MemoriaFisica *mem, int k) {
+    int frame = mem->fila_fifo[(mem->fifo_inicio + k) % mem->num_frames];
+    for (int j = k; j > 0; j--)
+        mem->fila_fifo[(mem->fifo_inicio + j) % mem->num_frames] =
+            mem->fila_fifo[(mem->fifo_inicio + j - 1) % mem->num_frames];
+    mem->fifo_inicio = (mem->fifo_inicio + 1) % mem->num_frames;
+    mem->fifo_tamanho--;
+    return frame;
+}
+
+// Compacta a fila do FIFO descartando frames que ficaram livres
+static void compactaFilaFIFO(MemoriaFisica *mem) {
+    int mantidos = 0;
+    for (int k = 0; k < mem->fifo_tamanho; k++) {
+        int frame = mem->fila_fifo[(mem->fifo_inicio + k) % mem->num_frames];
+        if (mem->frames[frame].pid != -1)
+            mem->fila_fifo[(mem->fifo_inicio + mantidos++) % mem->num_frames] = frame;
+    }
+    mem->fifo_tamanho = mantidos;
+}
+
+// Desaloca a página que ocupa o frame (o frame continua reservado)
+static void removePaginaDoFrame(Simulador *sim, int frame) {
+    Pagina *pag_vitima = paginaDoFrame(sim, frame);
+    if (pag_vitima)
+        *pag_vitima = 0;
+    esqueceEntrada(sim, frame);
+    const EntradaFrame *ef = &sim->memoria.frames[frame];
+    if (ef->pid != -1) {
+        invalidaTLB(&sim->tlb, chavePagina(sim, ef->pid, ef->pagina), 0);
+        if (sim->memoria.grandes.blocos)
+            paginaSaiuGrandes(sim, frame);
+        Processo *dono = buscaProcesso(sim, ef->pid);
+        if (dono)
+            dono->residentes--;
+    }
+    if (sim->memoria.pronta_ns[frame] >= 0)
+        descartaAntecipada(sim, frame);
+    sim->memoria.frames[frame].pid = -1;
+    sim->memoria.frames[frame].pagina = -1;
+    sim->memoria.frames[frame].entrada = NULL;
+}
+
+// Registra a página no frame, na tabela de páginas e na tabela invertida. Retorna 1 se
+// ela veio da memória comprimida (e não do disco)
+static int carregaPagina(Simulador *sim, int frame, Processo *proc, int64_t num_pag, Pagina *pag) {
+    int origem = comprimidaAtiva(sim) ? retiraComprimida(sim, proc->pid, num_pag) : -1;
+    // Sem a versão atual no disco, a página precisa ser gravada quando sair de novo
+    *pag = PAG_PRESENTE | (Pagina)frame | (origem == 1 ? PAG_MODIFICADA : 0);
+    sim->memoria.frames[frame].pid = proc->pid;
+    sim->memoria.frames[frame].pagina = num_pag;
+    sim->memoria.frames[frame].entrada = pag;
+    sim->memoria.uso_virtual[frame] = proc->acessos;
+    proc->residentes++;
+    return origem >= 0;
+}
+
+// Aloca as estruturas da memória física para num_frames frames
+int alocaMemoriaFisica(MemoriaFisica *mem, int num_frames) {
+    mem->num_frames = num_frames;
+    mem->frames = malloc(num_frames * sizeof(EntradaFrame));
+    mem->fila_fifo = malloc(num_frames * sizeof(int));
+    mem->livres = malloc(num_frames * sizeof(int));
+    mem->tempo_carga = malloc(num_frames * sizeof(int64_t));
+    mem->ultimo_acesso = malloc(num_frames * sizeof(int64_t));
+    mem->pronta_ns = malloc(num_frames * sizeof(double));
+    mem->uso_virtual = malloc(num_frames * sizeof(int64_t));
+    mem->adaptativo.nos = NULL; // Alocado no primeiro uso do ARC, 2Q ou LIRS
+    mem->adaptativo.no_do_frame = NULL;
+    mem->otimo.proximo_uso = NULL; // Heap alocado no primeiro uso do OPT
+    mem->otimo.chave = NULL;
+    mem->otimo.heap = NULL;
+    mem->otimo.posicao = NULL;
+    mem->entradas_invertidas = NULL; // Alocada no primeiro uso da tabela invertida
+    memset(&mem->hash_invertida, 0, sizeof(MapaHash));
+    memset(&mem->grandes, 0, sizeof(EstadoGrandes)); // Montado no primeiro uso das páginas grandes
+    memset(&mem->comprimida, 0, sizeof(EstadoComprimida)); // Montado na primeira página guardada
+    mem->comprimida.cabeca = mem->comprimida.cauda = -1;
+    if (num_frames > 0 && (!mem->frames || !mem->fila_fifo || !mem->livres ||
+                           !mem->tempo_carga || !mem->ultimo_acesso || !mem->pronta_ns ||
+                           !mem->uso_virtual)) {
+        liberaMemoriaFisica(mem);
+        return -1;
+    }
+    return 0;
+}
+
+// Libera as estruturas da memória física
+void liberaMemoriaFisica(MemoriaFisica *mem) {
+    free(mem->frames);
+    free(mem->fila_fifo);
+    free(mem->livres);
+    free(mem->tempo_carga);
+    free(mem->ultimo_acesso);
+    free(mem->pronta_ns);
+    free(mem->uso_virtual);
+    liberaAdaptativo(mem);
+    liberaOtimo(mem);
+    liberaInvertida(mem);
+    liberaGrandes(mem);
+    liberaComprimida(mem);
+    mem->frames = NULL;
+    mem->fila_fifo = NULL;
+    mem->livres = NULL;
+    mem->tempo_carga = NULL;
+    mem->ultimo_acesso = NULL;
+    mem->pronta_ns = NULL;
+    mem->uso_virtual = NULL;
+    mem->num_frames = 0;
+}
+
 // Reinicializa memória para estado inicial
 void reinicializarMemoria(Simulador *sim) {
-    // Libera todos os frames
-    for (int i = 0; i < sim->memoria.num_frames; i++) {
-        sim->memoria.frames[i] = -1;
+    MemoriaFisica *mem = &sim->memoria;
+
+    // Libera todos os frames (pilha devolve primeiro o frame 0)
+    for (int i = 0; i < mem->num_frames; i++) {
+        mem->frames[i].pid = -1;
+        mem->frames[i].pagina = -1;
+        mem->frames[i].entrada = NULL;
+        mem->frames[i].ant = -1;
+        mem->frames[i].prox = -1;
+        mem->tempo_carga[i] = 0;
+        mem->ultimo_acesso[i] = 0;
+        mem->pronta_ns[i] = -1.0;
+        mem->uso_virtual[i] = 0;
+        mem->livres[i] = mem->num_frames - 1 - i;
     }
+    mem->num_livres = mem->num_frames;
+
+    // Esvazia estruturas de substituição
+    mem->lru_cabeca = -1;
+    mem->lru_cauda = -1;
+    mem->fifo_inicio = 0;
+    mem->fifo_tamanho = 0;
+    mem->ponteiro_relogio = 0;
+    reiniciaAdaptativo(mem);
+    reiniciaOtimo(mem);
+    reiniciaInvertida(mem);
+    reiniciaGrandes(mem);
+    reiniciaComprimida(mem);
+    reiniciaTLB(&sim->tlb);
 
     // Reseta tabelas de páginas de todos os processos
     for (int i = 0; i < sim->num_processos; i++) {
-        for (int j = 0; j < sim->processos[i].num_paginas; j++) {
-            sim->processos[i].tabela_paginas[j].presente = 0;
-            sim->processos[i].tabela_paginas[j].frame = -1;
-            sim->processos[i].tabela_paginas[j].ultimo_acesso = 0;
-            sim->processos[i].tabela_paginas[j].tempo_carga = 0;
-        }
+        Processo *proc = &sim->processos[i];
+        limpaTabela(sim, proc);
+        reiniciaFluxo(proc);
+        proc->acessos = 0;
+        proc->faltas = 0;
+        proc->ultima_falta = 0;
+        proc->residentes = 0;
     }
+    recalculaCotas(sim);
+    reiniciaEstatisticas(sim);
 
     // Reseta estatísticas
     sim->total_acessos = 0;
     sim->page_faults = 0;
+    sim->escritas_disco = 0;
+    sim->antecipadas = 0;
+    sim->antecipadas_uteis = 0;
+    sim->antecipadas_atrasadas = 0;
+    sim->antecipadas_desperdicadas = 0;
+    sim->espera_antecipacao_ns = 0.0;
+    sim->faltas_intervalo = 0;
+    sim->intervalos = 0;
+    sim->intervalos_thrashing = 0;
+    sim->faltas_sem_folga = 0;
+    sim->promocoes = 0;
+    sim->rebaixamentos = 0;
+    sim->reservas_desfeitas = 0;
+    sim->faltas_sem_bloco = 0;
+    sim->preenchidas = 0;
+    sim->preenchidas_usadas = 0;
+    sim->hits_tlb_grandes = 0;
+    sim->comprimidas = 0;
+    sim->rejeitadas = 0;
+    sim->descomprimidas = 0;
+    sim->faltas_comprimidas = 0;
+    sim->devolvidas = 0;
+    sim->devolvidas_gravadas = 0;
+    sim->pico_comprimida = 0;
     sim->tempo_atual = 1;
 }
 
-// Seleciona algoritmo para tradução de endereço
-int traduzEndereco(Simulador *sim, int pid, int endereco_virtual) {
-    switch (sim->algoritmo) {
-        case 0: return traduzEnderecoFIFO(sim, pid, endereco_virtual);
-        case 1: return traduzEnderecoLRU(sim, pid, endereco_virtual);
-        default:
-            printf("Algoritmo invalido!\n");
+// log2 do tamanho da página se for potência de 2; -1 se não for
+int bitsDeslocamento(int tamanho_pagina) {
+    if (tamanho_pagina <= 0 || (tamanho_pagina & (tamanho_pagina - 1)))
+        return -1;
+    int bits = 0;
+    while ((1 << bits) != tamanho_pagina)
+        bits++;
+    return bits;
+}
+
+// Bits do maior número de página de um endereço virtual de BITS_ENDERECO_VIRTUAL bits
+int bitsNumeroPagina(int tamanho_pagina) {
+    int64_t max_pag = ((INT64_C(1) << BITS_ENDERECO_VIRTUAL) - 1) / tamanho_pagina;
+    int bits = 1;
+    while ((max_pag >> bits) != 0)
+        bits++;
+    return bits;
+}
+
+// Recalcula shift, máscara e bits do número da página para o tamanho atual
+static void calculaGeometria(Simulador *sim) {
+    sim->bits_desloc = bitsDeslocamento(sim->tamanho_pagina);
+    sim->mascara_desloc = (int64_t)sim->tamanho_pagina - 1;
+    sim->bits_pagina = bitsNumeroPagina(sim->tamanho_pagina);
+}
+
+// O pid precisa caber nos bits acima do número da página em chavePagina
+static int pidCabe(const Simulador *sim, int pid) {
+    return pid >= 0 && (sim->bits_pagina <= 32 || ((uint64_t)pid >> (64 - sim->bits_pagina)) == 0);
+}
+
+// Inicializa o simulador com valores padrão
+void inicializarSimulador(Simulador *sim) {
+    sim->tempo_atual = 1;
+    sim->tamanho_pagina = 4096;        // 4KB por página
+    sim->tamanho_memoria_fisica = 12288; // 12KB de memória física
+    calculaGeometria(sim);
+    sim->num_processos = 0;
+    sim->processos = NULL;
+    mapaInicializa(&sim->indice_processos, 16);
+    sim->modo_tabela = TABELA_LINEAR;
+    sim->niveis = NIVEIS_PADRAO;
+    recalculaNiveis(sim);
+    memset(&sim->tlb, 0, sizeof(TLB)); // TLB desligada até configuraTLB
+    sim->latencias.memoria = LATENCIA_MEMORIA_PADRAO;
+    sim->latencias.falta = LATENCIA_FALTA_PADRAO;
+    sim->latencias.escrita = LATENCIA_ESCRITA_PADRAO;
+    sim->latencias.compressao = LATENCIA_COMPRESSAO_PADRAO;
+    sim->latencias.descompressao = LATENCIA_DESCOMPRESSAO_PADRAO;
+    sim->janela_limpas = 0;
+    sim->antecipacao.politica = ANTECIPA_NENHUMA;
+    sim->antecipacao.paginas = ANTECIPA_PAGINAS_PADRAO;
+    sim->alocacao.modo = ALOCA_GLOBAL;
+    sim->alocacao.janela = ALOCA_JANELA_PADRAO;
+    sim->alocacao.limiar_thrashing = ALOCA_LIMIAR_PADRAO;
+    sim->grandes.fator = 0; // Páginas grandes desligadas
+    sim->grandes.limiar = GRANDES_LIMIAR_PADRAO;
+    sim->comprimida.capacidade = 0; // Memória comprimida desligada
+    sim->comprimida.num_razoes = 1;
+    sim->comprimida.razoes[0] = COMPRIMIDA_RAZAO_PADRAO;
+    sim->comprimida.acumuladas[0] = 1.0;
+    sim->estatisticas = NULL; // Ligadas por ativaEstatisticas
+    sim->eventos = NULL;      // Ligado por abreLogEventos
+
+    // Calcula número de frames na memória física
+    alocaMemoriaFisica(&sim->memoria, (int)(sim->tamanho_memoria_fisica / sim->tamanho_pagina));
+    
+    // Inicializa todos os frames como livres
+    reinicializarMemoria(sim);
+
+    // Inicializa estatísticas
+    sim->total_acessos = 0;
+    sim->page_faults = 0;
+    sim->escritas_disco = 0;
+    sim->algoritmo = 0;                // FIFO padrão
+    sim->verbosidade = VERBOSIDADE_COMPLETO;
+}
+
+// Libera toda a memória alocada
+void liberarSimulador(Simulador *sim) {
+    // Libera tabelas de páginas de cada processo
+    for (int i = 0; i < sim->num_processos; i++)
+        liberaTabela(sim, &sim->processos[i]);
+    free(sim->processos);
+    mapaLibera(&sim->indice_processos);
+    liberaMemoriaFisica(&sim->memoria);
+    liberaTLB(&sim->tlb);
+    fechaLogEventos(sim);
+    desativaEstatisticas(sim);
+}
+
+// Ajusta tamanhos de página e memória, realocando frames se o número mudou
+int configuraMemoria(Simulador *sim, int tamanho_pagina, int64_t tamanho_memoria_fisica) {
+    if (tamanho_pagina <= 0 || tamanho_memoria_fisica < tamanho_pagina ||
+        tamanho_memoria_fisica / tamanho_pagina > PAG_MAX_FRAMES)
+        return -1; // Não cabe no campo de frame da PTE
+    int novos_frames = (int)(tamanho_memoria_fisica / tamanho_pagina);
+    // Páginas menores deixam menos bits para o pid nas chaves
+    int bits_pagina = bitsNumeroPagina(tamanho_pagina);
+    for (int i = 0; i < sim->num_processos; i++) {
+        if (bits_pagina > 32 && ((uint64_t)sim->processos[i].pid >> (64 - bits_pagina)) != 0)
             return -1;
     }
+
+    // Outra página muda a divisão do endereço entre os níveis: esvazia as
+    // tabelas com a divisão antiga antes de recalculá-la
+    int mudou_pagina = tamanho_pagina != sim->tamanho_pagina;
+    if (mudou_pagina)
+        reinicializarMemoria(sim);
+    sim->tamanho_pagina = tamanho_pagina;
+    sim->tamanho_memoria_fisica = tamanho_memoria_fisica;
+    calculaGeometria(sim);
+    recalculaNiveis(sim);
+
+    if (novos_frames != sim->memoria.num_frames) {
+        liberaMemoriaFisica(&sim->memoria);
+        if (alocaMemoriaFisica(&sim->memoria, novos_frames) != 0)
+            return -1;
+        reinicializarMemoria(sim);
+    }
+    return 0;
 }
 
-// Implementação do algoritmo FIFO
-int traduzEnderecoFIFO(Simulador *sim, int pid, int endereco_virtual) {
-    int tam_pag = sim->tamanho_pagina;
-    int num_pag = endereco_virtual / tam_pag; // Página virtual
-    int desloc = endereco_virtual % tam_pag;   // Offset
+// Nomes dos algoritmos, na ordem dos valores ALG_*
+static const char *nomes_algoritmos[NUM_ALGORITMOS] = {
+    "FIFO", "LRU", "CLOCK", "SEGUNDA-CHANCE", "CLOCK-MELHORADO", "ARC", "2Q", "LIRS", "OPT"};
 
-    // Localiza processo
-    Processo *proc = NULL;
-    for (int i = 0; i < sim->num_processos; i++) {
-        if (sim->processos[i].pid == pid) {
-            proc = &sim->processos[i];
-            break;
-        }
+// Retorna o nome do algoritmo
+const char *nomeAlgoritmo(int algoritmo) {
+    if (algoritmo < 0 || algoritmo >= NUM_ALGORITMOS)
+        return "?";
+    return nomes_algoritmos[algoritmo];
+}
+
+// Compara nomes sem diferenciar maiúsculas de minúsculas
+static int nomesIguais(const char *a, const char *b) {
+    while (*a && tolower((unsigned char)*a) == tolower((unsigned char)*b)) {
+        a++;
+        b++;
     }
-    if (!proc) {
-        fprintf(stderr, "Processo %d nao encontrado!\n", pid);
+    return tolower((unsigned char)*a) == tolower((unsigned char)*b);
+}
+
+// Posição do nome entre os n nomes, ou o número dado em texto se for menor que n;
+// -1 se inválido. Usado por todas as opções que aceitam nome ou número
+int indicePorNome(const char *nome, const char *const *nomes, int n) {
+    for (int i = 0; i < n; i++) {
+        if (nomesIguais(nomes[i], nome))
+            return i;
+    }
+    char *fim;
+    long valor = strtol(nome, &fim, 10);
+    if (fim != nome && *fim == '\0' && valor >= 0 && valor < n)
+        return (int)valor;
+    return -1;
+}
+
+// Converte nome ou número do algoritmo no valor ALG_*; -1 se inválido
+int algoritmoPorNome(const char *nome) {
+    return indicePorNome(nome, nomes_algoritmos, NUM_ALGORITMOS);
+}
+
+// Cria processo com tabela de páginas vazia e registra no índice
+Processo *adicionaProcesso(Simulador *sim, int pid, int64_t num_paginas) {
+    if (buscaProcesso(sim, pid)) {
+        fprintf(stderr, "Processo %d ja existe!\n", pid);
+        return NULL;
+    }
+    if (!pidCabe(sim, pid)) {
+        fprintf(stderr, "Pid %d grande demais para paginas de %d bytes!\n", pid,
+                sim->tamanho_pagina);
+        return NULL;
+    }
+
+    Processo *novos = realloc(sim->processos, (sim->num_processos + 1) * sizeof(Processo));
+    if (!novos)
+        return NULL;
+    sim->processos = novos;
+
+    Processo *proc = &sim->processos[sim->num_processos];
+    proc->pid = pid;
+    proc->num_paginas = num_paginas;
+    proc->tamanho = num_paginas * sim->tamanho_pagina;
+    reiniciaFluxo(proc);
+    proc->acessos = 0;
+    proc->faltas = 0;
+    proc->ultima_falta = 0;
+    proc->residentes = 0;
+    proc->cota = 0;
+    proc->expulsas = 0;
+    if (criaTabela(sim, proc) != 0)
+        return NULL;
+
+    if (mapaInsere(&sim->indice_processos, (uint32_t)pid, sim->num_processos) != 0) {
+        liberaTabela(sim, proc);
+        return NULL;
+    }
+    sim->num_processos++;
+    recalculaCotas(sim);
+    return proc;
+}
+
+// Aumenta o espaço do processo para ao menos num_paginas páginas
+int garantePaginas(Simulador *sim, Processo *proc, int64_t num_paginas) {
+    if (num_paginas <= proc->num_paginas)
+        return 0;
+    // Cresce em dobro para amortizar realocações em traces longos (e deixar espaço
+    // para a leitura antecipada seguir um fluxo além da maior página já vista)
+    int64_t max_paginas = ((INT64_C(1) << BITS_ENDERECO_VIRTUAL) - 1) / sim->tamanho_pagina + 1;
+    int64_t nova_qtd = proc->num_paginas * 2;
+    if (nova_qtd < num_paginas)
+        nova_qtd = num_paginas;
+    if (nova_qtd > max_paginas)
+        nova_qtd = max_paginas > num_paginas ? max_paginas : num_paginas;
+    // Só a tabela linear tem uma entrada por página; as outras crescem no acesso
+    if (sim->modo_tabela != TABELA_LINEAR) {
+        proc->num_paginas = nova_qtd;
+        proc->tamanho = nova_qtd * sim->tamanho_pagina;
+        if (sim->alocacao.modo == ALOCA_PROPORCIONAL)
+            recalculaCotas(sim);
+        return 0;
+    }
+
+    if ((uint64_t)nova_qtd > SIZE_MAX / sizeof(Pagina))
         return -1;
+    Pagina *nova = realloc(proc->tabela_paginas, (size_t)nova_qtd * sizeof(Pagina));
+    if (!nova)
+        return -1;
+    memset(nova + proc->num_paginas, 0, (size_t)(nova_qtd - proc->num_paginas) * sizeof(Pagina));
+    // A tabela pode ter mudado de endereço: atualiza os frames que apontam para ela
+    for (int64_t i = 0; i < proc->num_paginas; i++) {
+        if (nova[i] & PAG_PRESENTE)
+            sim->memoria.frames[paginaFrame(nova[i])].entrada = &nova[i];
     }
+    proc->tabela_paginas = nova;
+    proc->num_paginas = nova_qtd;
+    proc->tamanho = nova_qtd * sim->tamanho_pagina;
+    if (sim->alocacao.modo == ALOCA_PROPORCIONAL)
+        recalculaCotas(sim);
+    return 0;
+}
 
-    Pagina *pag = &proc->tabela_paginas[num_pag];
-    sim->total_acessos++;
+// Empilha o frame livre (com páginas grandes, registra também a posição dele)
+static void empilhaLivre(MemoriaFisica *mem, int frame) {
+    mem->livres[mem->num_livres++] = frame;
+    if (mem->grandes.blocos)
+        livreEmpilhado(mem, frame);
+}
 
-    // Trata page fault
-    if (!pag->presente) {
-        printf("Tempo t=%d: [PAGE FAULT] Pagina %d do Processo %d\n",
-               sim->tempo_atual, num_pag, pid);
-        sim->page_faults++;
+// Devolve o frame para a pilha de livres, tirando-o das estruturas de substituição
+static void liberaFrame(Simulador *sim, int frame) {
+    MemoriaFisica *mem = &sim->memoria;
+    // Só está na lista de recência quem tem vizinho ou é a própria cabeça
+    if (mem->frames[frame].ant != -1 || mem->lru_cabeca == frame)
+        lruRemove(mem, frame);
+    liberaFrameAdaptativo(mem, frame);
+    liberaFrameOtimo(mem, frame);
+    removePaginaDoFrame(sim, frame);
+    empilhaLivre(mem, frame);
+}
 
-        int frame_substituicao = -1;
-        int min_tempo = sim->tempo_atual + 1; // Inicializa com valor alto
-
-        // Procura frame livre ou página mais antiga
-        for (int i = 0; i < sim->memoria.num_frames; i++) {
-            if (sim->memoria.frames[i] == -1) {
-                frame_substituicao = i;
-                break;
-            } else {
-                // Procura página com menor tempo de carga (mais antiga)
-                for (int p = 0; p < sim->num_processos; p++) {
-                    Processo *proc_frame = &sim->processos[p];
-                    for (int pg = 0; pg < proc_frame->num_paginas; pg++) {
-                        Pagina *pag_frame = &proc_frame->tabela_paginas[pg];
-                        if (pag_frame->presente && pag_frame->frame == i) {
-                            if (pag_frame->tempo_carga < min_tempo) {
-                                min_tempo = pag_frame->tempo_carga;
-                                frame_substituicao = i;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+// Remove processo, liberando seus frames e atualizando o índice
+int removeProcesso(Simulador *sim, int pid) {
+    int64_t indice;
+    if (!mapaBusca(&sim->indice_processos, (uint32_t)pid, &indice))
+        return -1;
+    Processo *proc = &sim->processos[indice];
+    MemoriaFisica *mem = &sim->memoria;
 
-        // Fallback se não encontrou
-        if (frame_substituicao == -1) {
-            frame_substituicao = 0;
+    // Libera os frames ocupados pelo processo (achados pela tabela invertida de frames)
+    for (int f = 0; f < mem->num_frames; f++) {
+        if (mem->frames[f].pid == pid) {
+            if (observando(sim))
+                observaExpulsao(sim, f, EXPULSAO_PROCESSO);
+            liberaFrame(sim, f);
         }
+    }
 
-        // Remove página atual do frame selecionado
-        for (int p = 0; p < sim->num_processos; p++) {
-            Processo *proc_vitima = &sim->processos[p];
-            for (int pg = 0; pg < proc_vitima->num_paginas; pg++) {
-                Pagina *pag_vitima = &proc_vitima->tabela_paginas[pg];
-                if (pag_vitima->presente && pag_vitima->frame == frame_substituicao) {
-                    pag_vitima->presente = 0;
-                }
-            }
+    compactaFilaFIFO(mem);
+    if (comprimidaAtiva(sim))
+        esqueceProcessoComprimida(sim, pid);
+
+    // Move o último processo para a posição liberada
+    liberaTabela(sim, proc);
+    mapaRemove(&sim->indice_processos, (uint32_t)pid);
+    sim->num_processos--;
+    if (indice != sim->num_processos) {
+        sim->processos[indice] = sim->processos[sim->num_processos];
+        mapaInsere(&sim->indice_processos, (uint32_t)sim->processos[indice].pid, indice);
+    }
+    recalculaCotas(sim);
+    return 0;
+}
+
+// Indica se a página do frame foi escrita e precisa ser gravada ao sair
+static int frameModificado(const Simulador *sim, int frame) {
+    const Pagina *pag = paginaDoFrame(sim, frame);
+    return pag && (*pag & PAG_MODIFICADA);
+}
+
+// Destinos da página que sai da memória (retorno de despejaPagina)
+#define DESTINO_DESCARTADA 0 // Limpa: o disco já tem a página
+#define DESTINO_DISCO      1 // Modificada e gravada no disco
+#define DESTINO_COMPRIMIDA 2 // Guardada na memória comprimida
+
+// Destino da página que sai do frame: a memória comprimida, se ligada e a página
+// couber nela, ou o disco, que só recebe a página modificada. Retorna o DESTINO_*
+static int despejaPagina(Simulador *sim, int frame) {
+    int modificada = frameModificado(sim, frame);
+    if (comprimidaAtiva(sim) && guardaComprimida(sim, frame, modificada) == 0)
+        return DESTINO_COMPRIMIDA;
+    if (!modificada)
+        return DESTINO_DESCARTADA;
+    sim->escritas_disco++;
+    return DESTINO_DISCO;
+}
+
+// Devolve à pilha de livres os frames do processo sem uso desde o tempo virtual limite,
+// gravando as páginas modificadas; motivo é o EXPULSAO_* registrado. Retorna quantos
+// foram liberados
+int liberaFramesOciosos(Simulador *sim, Processo *proc, int64_t limite, int motivo) {
+    MemoriaFisica *mem = &sim->memoria;
+    int liberados = 0;
+    for (int f = 0; f < mem->num_frames && proc->residentes > 0; f++) {
+        if (mem->frames[f].pid != proc->pid || mem->uso_virtual[f] > limite)
+            continue;
+        despejaPagina(sim, f);
+        if (observando(sim))
+            observaExpulsao(sim, f, motivo);
+        liberaFrame(sim, f);
+        liberados++;
+    }
+    if (liberados)
+        compactaFilaFIFO(mem);
+    return liberados;
+}
+
+// O frame pode sair sob a restrição imposta pelo modo de alocação
+static int podeSair(const Simulador *sim, int frame, int restricao, int pid) {
+    return restricao == VITIMA_QUALQUER || frameElegivel(sim, frame, restricao, pid);
+}
+
+// Páginas modificadas que os relógios e a segunda chance podem pular (uma volta no máximo)
+static int pulosPermitidos(const Simulador *sim) {
+    return sim->janela_limpas < sim->memoria.num_frames ? sim->janela_limpas
+                                                        : sim->memoria.num_frames;
+}
+
+// FIFO: primeira da fila que pode sair ou, com a janela ligada, a página limpa mais
+// antiga entre as janela_limpas primeiras (a ordem das demais é mantida)
+static int vitimaFIFO(Simulador *sim, int restricao, int pid) {
+    MemoriaFisica *mem = &sim->memoria;
+    int primeira = -1;
+    int limpas = sim->janela_limpas;
+    for (int k = 0; k < mem->fifo_tamanho; k++) {
+        int frame = mem->fila_fifo[(mem->fifo_inicio + k) % mem->num_frames];
+        if (!podeSair(sim, frame, restricao, pid))
+            continue;
+        if (primeira < 0)
+            primeira = k;
+        if (limpas-- <= 0)
+            break;
+        if (!frameModificado(sim, frame))
+            return fifoRetiraPosicao(mem, k);
+    }
+    return primeira >= 0 ? fifoRetiraPosicao(mem, primeira) : -1;
+}
+
+// LRU: a menos recente que pode sair ou a página limpa menos recente entre as
+// janela_limpas últimas
+static int vitimaLRU(Simulador *sim, int restricao, int pid) {
+    MemoriaFisica *mem = &sim->memoria;
+    int frame = -1;
+    int limpas = sim->janela_limpas;
+    for (int f = mem->lru_cauda; f != -1; f = mem->frames[f].ant) {
+        if (!podeSair(sim, f, restricao, pid))
+            continue;
+        if (frame < 0)
+            frame = f;
+        if (limpas-- <= 0)
+            break;
+        if (!frameModificado(sim, f)) {
+            frame = f;
+            break;
         }
+    }
+    if (frame >= 0)
+        lruRemove(mem, frame);
+    return frame;
+}
 
-        // Carrega nova página
-        printf("Tempo t=%d: Carregando Pagina %d do Processo %d no Frame %d\n",
-               sim->tempo_atual, num_pag, pid, frame_substituicao);
+// Relógio: avança o ponteiro zerando R até achar página com R=0 (com a janela
+// ligada, pula até janela_limpas páginas modificadas). Três voltas bastam: se só
+// sobraram modificadas, fica a primeira pulada
+static int vitimaClock(Simulador *sim, int restricao, int pid) {
+    MemoriaFisica *mem = &sim->memoria;
+    int pulos = pulosPermitidos(sim);
+    int pulada = -1;
+    for (int passo = 0; passo < 3 * mem->num_frames; passo++) {
+        int frame = mem->ponteiro_relogio;
+        mem->ponteiro_relogio = (frame + 1) % mem->num_frames;
+        Pagina *pag = paginaDoFrame(sim, frame);
+        if (!pag)
+            return frame;
+        if (!podeSair(sim, frame, restricao, pid))
+            continue;
+        if (!(*pag & PAG_REFERENCIADA)) {
+            if (!(*pag & PAG_MODIFICADA) || pulos-- <= 0)
+                return frame;
+            if (pulada < 0)
+                pulada = frame;
+            continue;
+        }
+        *pag &= ~PAG_REFERENCIADA;
+    }
+    return pulada;
+}
 
-        pag->presente = 1;
-        pag->frame = frame_substituicao;
-        pag->tempo_carga = sim->tempo_atual; // Marca tempo de carga
-        sim->memoria.frames[frame_substituicao] = pid;
-        sim->tempo_atual++;
+// Segunda chance: retira da fila a primeira que pode sair, reinserindo no final quem
+// tem R=1 (e, com a janela ligada, até janela_limpas páginas modificadas)
+static int vitimaSegundaChance(Simulador *sim, int restricao, int pid) {
+    MemoriaFisica *mem = &sim->memoria;
+    int pulos = pulosPermitidos(sim);
+    // Quem não pode sair fica no lugar; k avança sobre eles
+    for (int k = 0, passo = 0; k < mem->fifo_tamanho && passo < 3 * mem->num_frames; passo++) {
+        int frame = mem->fila_fifo[(mem->fifo_inicio + k) % mem->num_frames];
+        Pagina *pag = paginaDoFrame(sim, frame);
+        if (pag && !podeSair(sim, frame, restricao, pid)) {
+            k++;
+            continue;
+        }
+        fifoRetiraPosicao(mem, k);
+        if (!pag)
+            return frame;
+        if (!(*pag & PAG_REFERENCIADA)) {
+            if (!(*pag & PAG_MODIFICADA) || pulos-- <= 0)
+                return frame;
+        } else {
+            *pag &= ~PAG_REFERENCIADA;
+        }
+        fifoInsere(mem, frame);
+    }
+    return -1;
+}
 
-        // Mostra estado da memória após substituição
-        imprimeEstadoMemoria(sim);
-    } else {
-        // Hit de página
-        printf("Tempo t=%d: [HIT] Pagina %d do Processo %d no Frame %d\n",
-               sim->tempo_atual, num_pag, pid, pag->frame);
-        sim->tempo_atual++;
+// Relógio melhorado (NRU): procura a menor classe (R,M), no máximo quatro voltas.
+// Já prefere páginas limpas por construção, então ignora janela_limpas
+static int vitimaClockMelhorado(Simulador *sim, int restricao, int pid) {
+    MemoriaFisica *mem = &sim->memoria;
+    for (int volta = 0; volta < 4; volta++) {
+        // Voltas pares procuram (0,0) sem alterar bits; ímpares procuram (0,1) zerando R
+        Pagina classe = (volta & 1) ? PAG_MODIFICADA : 0;
+        for (int k = 0; k < mem->num_frames; k++) {
+            int frame = mem->ponteiro_relogio;
+            mem->ponteiro_relogio = (frame + 1) % mem->num_frames;
+            Pagina *pag = paginaDoFrame(sim, frame);
+            if (pag && !podeSair(sim, frame, restricao, pid))
+                continue;
+            // Compara R e M de uma vez com a classe procurada
+            if (!pag || (*pag & (PAG_REFERENCIADA | PAG_MODIFICADA)) == classe)
+                return frame;
+            if (classe)
+                *pag &= ~PAG_REFERENCIADA;
+        }
     }
+    return -1;
+}
 
-    // Calcula endereço físico
-    int endereco_fisico = (pag->frame * tam_pag) + desloc;
-    printf("Endereco Virtual: %d -> Endereco Fisico: %d\n", endereco_virtual, endereco_fisico);
-    printf("Detalhes: Pagina=%d, Desloc=%d, Frame=%d\n\n", num_pag, desloc, pag->frame);
-    printf("................................................................\n\n");
+// Escolhe o frame vítima e o retira das estruturas do algoritmo; -1 se nenhum frame
+// pode sair sob a restrição
+static int escolheVitima(Simulador *sim, int algoritmo, int restricao, int pid) {
+    switch (algoritmo) {
+        case ALG_FIFO:            return vitimaFIFO(sim, restricao, pid);
+        case ALG_LRU:             return vitimaLRU(sim, restricao, pid);
+        case ALG_CLOCK:           return vitimaClock(sim, restricao, pid);
+        case ALG_SEGUNDA_CHANCE:  return vitimaSegundaChance(sim, restricao, pid);
+        case ALG_CLOCK_MELHORADO: return vitimaClockMelhorado(sim, restricao, pid);
+        case ALG_OTIMO:           return vitimaOtimo(&sim->memoria);
+    }
+    return -1;
+}
 
-    return endereco_fisico;
+// Vítima conforme o modo de alocação. Sem candidata fora das cotas ou dos working sets
+// a demanda passou da memória: com cotas sai uma página do próprio processo; no working
+// set sai uma do processo com mais frames, no lugar de desativá-lo. Só as faltas
+// (motivo EXPULSAO_SUBSTITUICAO) contam em faltas_sem_folga, não a leitura antecipada
+static int vitimaDaAlocacao(Simulador *sim, int algoritmo, const Processo *proc, int motivo) {
+    int restricao = restricaoVitima(sim, proc);
+    int frame = escolheVitima(sim, algoritmo, restricao, proc->pid);
+    if (frame >= 0 || restricao == VITIMA_QUALQUER)
+        return frame;
+    if (restricao != VITIMA_DO_PROCESSO) {
+        if (motivo == EXPULSAO_SUBSTITUICAO)
+            sim->faltas_sem_folga++;
+        const Processo *cede = proc;
+        for (int i = 0; restricao == VITIMA_FORA_WS && i < sim->num_processos; i++) {
+            if (sim->processos[i].residentes > cede->residentes)
+                cede = &sim->processos[i];
+        }
+        if (cede->residentes > 0)
+            frame = escolheVitima(sim, algoritmo, VITIMA_DO_PROCESSO, cede->pid);
+    }
+    return frame >= 0 ? frame : escolheVitima(sim, algoritmo, VITIMA_QUALQUER, proc->pid);
 }
 
-// Implementação do algoritmo LRU
-int traduzEnderecoLRU(Simulador *sim, int pid, int endereco_virtual) {
-    int tam_pag = sim->tamanho_pagina;
-    int num_pag = endereco_virtual / tam_pag;
-    int desloc = endereco_virtual % tam_pag;
+// Obtém o frame para a página que faltou: livre de menor índice (com páginas grandes,
+// o reservado para ela) ou vítima do algoritmo (motivo é o EXPULSAO_* da vítima)
+static int obtemFrame(Simulador *sim, int algoritmo, const Processo *proc, int64_t num_pag,
+                      int motivo) {
+    MemoriaFisica *mem = &sim->memoria;
+    INSTR_INICIO(t_vitima);
+    int frame_livre = -1;
+    if (mem->num_livres > 0)
+        frame_livre = mem->grandes.blocos ? retiraLivreGrandes(sim, proc->pid, num_pag)
+                                          : mem->livres[--mem->num_livres];
+    int frame;
+    if (ehAdaptativo(algoritmo))
+        frame = faltaAdaptativa(mem, algoritmo, chavePagina(sim, proc->pid, num_pag),
+                                frame_livre, sim->janela_limpas);
+    else
+        frame = (frame_livre >= 0) ? frame_livre : vitimaDaAlocacao(sim, algoritmo, proc, motivo);
+    INSTR_FIM(FASE_VITIMA, t_vitima);
+    if (frame >= 0 && frame != frame_livre) {
+        // A página modificada precisa ser gravada no disco (ou comprimida) antes de
+        // liberar o frame
+        INSTR_INICIO(t_despejo);
+        int pid = mem->frames[frame].pid;
+        int64_t pagina = mem->frames[frame].pagina;
+        int destino = despejaPagina(sim, frame);
+        if (observando(sim))
+            observaExpulsao(sim, frame, motivo);
+        removePaginaDoFrame(sim, frame);
+        INSTR_FIM(FASE_DESPEJO, t_despejo);
+        if (destino != DESTINO_DESCARTADA && sim->verbosidade >= VERBOSIDADE_FALTAS) {
+            INSTR_INICIO(t_impressao);
+            printf("Tempo t=%lld: %s Pagina %lld do Processo %d (%s)\n",
+                   (long long)sim->tempo_atual - 1,
+                   destino == DESTINO_DISCO ? "Gravando" : "Comprimindo", (long long)pagina,
+                   pid, destino == DESTINO_DISCO ? "modificada" : "memoria comprimida");
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+        }
+    }
+    return frame;
+}
 
-    // Localiza processo
-    Processo *proc = NULL;
-    for (int i = 0; i < sim->num_processos; i++) {
-        if (sim->processos[i].pid == pid) {
-            proc = &sim->processos[i];
+// Registra o frame recém-carregado nas estruturas do algoritmo
+static void registraCarga(Simulador *sim, int algoritmo, int frame) {
+    switch (algoritmo) {
+        case ALG_FIFO:
+        case ALG_SEGUNDA_CHANCE:
+            fifoInsere(&sim->memoria, frame);
+            break;
+        case ALG_LRU:
+            lruInsereCabeca(&sim->memoria, frame);
+            break;
+        case ALG_OTIMO:
+            atualizaOtimo(&sim->memoria, frame);
             break;
+    }
+}
+
+// Carrega as páginas escolhidas pela leitura antecipada, sem contar page faults. Na
+// falta elas chegam junto com a página pedida; no uso de uma página antecipada a
+// nova leitura só termina depois de uma latência de falta
+static void antecipa(Simulador *sim, Processo *proc, int algoritmo, int64_t num_pag, int falta) {
+    int64_t paginas[ANTECIPA_PAGINAS_MAX];
+    int n = paginasAntecipar(sim, proc, num_pag, paginas);
+    double pronta = tempoDecorridoNs(sim) + (falta ? 0.0 : sim->latencias.falta);
+    for (int k = 0; k < n; k++) {
+        int64_t pagina = paginas[k];
+        Pagina *pag;
+        if (pagina < 0 || pagina >= proc->num_paginas)
+            continue;
+        if (buscaEntrada(sim, proc, pagina, &pag) != 0)
+            return;
+        if (pag && (*pag & PAG_PRESENTE))
+            continue;
+        int frame = obtemFrame(sim, algoritmo, proc, pagina, EXPULSAO_ANTECIPACAO);
+        if (frame < 0)
+            return;
+        if (sim->verbosidade >= VERBOSIDADE_FALTAS) {
+            INSTR_INICIO(t_impressao);
+            printf("Tempo t=%lld: [ANTECIPACAO] Pagina %lld do Processo %d no Frame %d\n",
+                   (long long)sim->tempo_atual - 1, (long long)pagina, proc->pid, frame);
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
         }
+
+        // Sem R: a página só conta como referenciada quando for acessada
+        pag = entradaDeCarga(sim, proc->pid, pagina, pag, frame);
+        carregaPagina(sim, frame, proc, pagina, pag);
+        sim->memoria.tempo_carga[frame] = sim->tempo_atual - 1;
+        sim->memoria.ultimo_acesso[frame] = sim->tempo_atual - 1;
+        sim->memoria.pronta_ns[frame] = pronta;
+        registraCarga(sim, algoritmo, frame);
+        sim->antecipadas++;
+        if (observando(sim))
+            observaAntecipacao(sim, proc, pagina, frame);
     }
-    if (!proc) {
-        fprintf(stderr, "Processo %d nao encontrado!\n", pid);
+}
+
+// Promove a região da página a página grande se o bloco reservado a ela já tem páginas
+// carregadas o bastante: as que faltam são carregadas nos seus frames do bloco, sem
+// contar page faults nem marcar R. Página da região carregada fora do bloco impede
+static void promoveRegiao(Simulador *sim, Processo *proc, int algoritmo, int64_t num_pag) {
+    int bloco = blocoParaPromover(sim, proc, num_pag, algoritmo);
+    if (bloco < 0)
+        return;
+    int fator = sim->memoria.grandes.fator;
+    int64_t primeira = num_pag / fator * fator;
+    Pagina *pag;
+    for (int s = 0; s < fator; s++) {
+        if (sim->memoria.frames[bloco * fator + s].pid == -1 &&
+            (buscaEntrada(sim, proc, primeira + s, &pag) != 0 || (pag && (*pag & PAG_PRESENTE))))
+            return;
+    }
+    for (int s = 0; s < fator; s++) {
+        int64_t pagina = primeira + s;
+        if (sim->memoria.frames[bloco * fator + s].pid != -1)
+            continue;
+        // O frame da página no bloco está livre: obtemFrame o devolve sem vítima
+        buscaEntrada(sim, proc, pagina, &pag);
+        int frame = obtemFrame(sim, algoritmo, proc, pagina, EXPULSAO_SUBSTITUICAO);
+        pag = entradaDeCarga(sim, proc->pid, pagina, pag, frame);
+        carregaPagina(sim, frame, proc, pagina, pag);
+        sim->memoria.tempo_carga[frame] = sim->tempo_atual - 1;
+        sim->memoria.ultimo_acesso[frame] = sim->tempo_atual - 1;
+        sim->memoria.grandes.preenchida[frame] = 1;
+        registraCarga(sim, algoritmo, frame);
+        sim->preenchidas++;
+        if (observando(sim))
+            observaAntecipacao(sim, proc, pagina, frame);
+    }
+    marcaPromovida(sim, bloco);
+}
+
+// Aloca as estruturas que o algoritmo usa e confere a configuração; basta uma vez
+// antes de uma sequência de traduções com o mesmo algoritmo. Retorna -1 se não dá
+// para traduzir
+int preparaTraducao(Simulador *sim, int algoritmo) {
+    if (algoritmo < 0 || algoritmo >= NUM_ALGORITMOS) {
+        printf("Algoritmo invalido!\n");
+        return -1;
+    }
+    if (sim->memoria.num_frames <= 0) {
+        fprintf(stderr, "Memoria fisica sem frames!\n");
         return -1;
     }
+    if (ehAdaptativo(algoritmo) && preparaAdaptativo(&sim->memoria) != 0) {
+        fprintf(stderr, "Sem memoria para as listas do %s!\n", nomeAlgoritmo(algoritmo));
+        return -1;
+    }
+    if (algoritmo == ALG_OTIMO) {
+        // O OPT precisa conhecer o futuro: só funciona reproduzindo um trace
+        if (!sim->memoria.otimo.proximo_uso) {
+            fprintf(stderr, "OPT so pode ser usado na reproducao de traces!\n");
+            return -1;
+        }
+        if (preparaOtimo(&sim->memoria) != 0) {
+            fprintf(stderr, "Sem memoria para o heap do OPT!\n");
+            return -1;
+        }
+    }
+    if (grandesAtivas(sim) && preparaGrandes(&sim->memoria, sim->grandes.fator) != 0) {
+        fprintf(stderr, "Sem memoria para as reservas de paginas grandes!\n");
+        return -1;
+    }
+    if (!alocacaoSuportada(sim->alocacao.modo, algoritmo)) {
+        fprintf(stderr, "Alocacao %s nao funciona com o %s!\n",
+                nomeModoAlocacao(sim->alocacao.modo), nomeAlgoritmo(algoritmo));
+        return -1;
+    }
+    return 0;
+}
 
-    Pagina *pag = &proc->tabela_paginas[num_pag];
-    sim->total_acessos++;
-    int tempo_atual = sim->tempo_atual++; // Usa e incrementa tempo
+// Tradução comum, com as estruturas já preparadas: os algoritmos diferem só na
+// vítima e no que fazem em hits. Retorna o endereço físico ou -1 em erro
+int64_t traduzAcesso(Simulador *sim, int algoritmo, Processo *proc, int64_t endereco_virtual,
+                     int escrita) {
+    INSTR_INICIO(t_traducao);
+    int pid = proc->pid;
+    int64_t num_pag = paginaDoEndereco(sim, endereco_virtual); // Página virtual
+    int64_t desloc = deslocDoEndereco(sim, endereco_virtual);  // Offset
 
-    // Trata page fault
-    if (!pag->presente) {
-        printf("Tempo t=%d: [PAGE FAULT] Pagina %d do Processo %d\n",
-               tempo_atual, num_pag, pid);
-        sim->page_faults++;
+    if (endereco_virtual < 0 || num_pag >= proc->num_paginas) {
+        fprintf(stderr, "Endereco %lld fora do espaco do Processo %d!\n",
+                (long long)endereco_virtual, pid);
+        return -1;
+    }
 
-        int frame_substituicao = -1;
-        int min_acesso = tempo_atual + 1; // Inicializa com valor alto
-
-        // Procura frame livre ou página menos recentemente usada
-        for (int i = 0; i < sim->memoria.num_frames; i++) {
-            if (sim->memoria.frames[i] == -1) {
-                frame_substituicao = i;
-                break;
-            } else {
-                // Procura página com acesso mais antigo
-                for (int p = 0; p < sim->num_processos; p++) {
-                    Processo *proc_frame = &sim->processos[p];
-                    for (int pg = 0; pg < proc_frame->num_paginas; pg++) {
-                        Pagina *pag_frame = &proc_frame->tabela_paginas[pg];
-                        if (pag_frame->presente && pag_frame->frame == i) {
-                            if (pag_frame->ultimo_acesso < min_acesso) {
-                                min_acesso = pag_frame->ultimo_acesso;
-                                frame_substituicao = i;
-                            }
-                        }
-                    }
-                }
-            }
+    // Hit na TLB: a entrada vem direto da tabela de frames, sem percorrer a tabela de
+    // páginas. Região promovida é traduzida pela entrada da página grande
+    INSTR_INICIO(t_tabela);
+    uint64_t chave = chavePagina(sim, pid, num_pag);
+    Pagina *pag;
+    int frame_tlb;
+    int bloco_grande = grandesAtivas(sim) ? blocoPromovido(sim, pid, num_pag) : -1;
+    if (bloco_grande >= 0) {
+        int fator = sim->memoria.grandes.fator;
+        frame_tlb = consultaTLB(&sim->tlb, pid, chavePagina(sim, pid, num_pag / fator), 1);
+        if (frame_tlb >= 0) {
+            frame_tlb += (int)(num_pag % fator);
+            sim->hits_tlb_grandes++;
         }
+    } else {
+        frame_tlb = consultaTLB(&sim->tlb, pid, chave, 0);
+    }
+    if (frame_tlb >= 0)
+        pag = paginaDoFrame(sim, frame_tlb);
+    else if (buscaEntrada(sim, proc, num_pag, &pag) != 0) {
+        fprintf(stderr, "Sem memoria para a tabela de paginas do Processo %d!\n", pid);
+        return -1;
+    }
+    INSTR_FIM(FASE_TABELA, t_tabela);
+    sim->total_acessos++;
+    int64_t tempo_atual = sim->tempo_atual++; // Usa e incrementa tempo
+    proc->acessos++;
+    int gatilho = 0; // Falta (1) ou uso de página antecipada (2) disparam a antecipação
 
-        // Fallback se não encontrou
-        if (frame_substituicao == -1) {
-            frame_substituicao = 0;
+    // Trata page fault (a tabela invertida não tem entrada para páginas ausentes)
+    if (!pag || !(*pag & PAG_PRESENTE)) {
+        if (sim->verbosidade >= VERBOSIDADE_FALTAS) {
+            INSTR_INICIO(t_impressao);
+            printf("Tempo t=%lld: [PAGE FAULT] Pagina %lld do Processo %d\n",
+                   (long long)tempo_atual, (long long)num_pag, pid);
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
         }
+        sim->page_faults++;
+        gatilho = 1;
+        ajustaAntesDaFalta(sim, proc);
+        if (sim->memoria.num_livres == 0)
+            sim->faltas_intervalo++;
 
-        // Remove página atual do frame
-        for (int p = 0; p < sim->num_processos; p++) {
-            Processo *proc_vitima = &sim->processos[p];
-            for (int pg = 0; pg < proc_vitima->num_paginas; pg++) {
-                Pagina *pag_vitima = &proc_vitima->tabela_paginas[pg];
-                if (pag_vitima->presente && pag_vitima->frame == frame_substituicao) {
-                    pag_vitima->presente = 0;
-                }
-            }
+        int frame_substituicao = obtemFrame(sim, algoritmo, proc, num_pag, EXPULSAO_SUBSTITUICAO);
+        if (frame_substituicao < 0) {
+            fprintf(stderr, "Sem frame para a Pagina %lld do Processo %d!\n",
+                    (long long)num_pag, pid);
+            return -1;
         }
 
         // Carrega nova página
-        printf("Tempo t=%d: Carregando Pagina %d do Processo %d no Frame %d\n",
-               tempo_atual, num_pag, pid, frame_substituicao);
+        if (sim->verbosidade >= VERBOSIDADE_FALTAS) {
+            INSTR_INICIO(t_impressao);
+            printf("Tempo t=%lld: Carregando Pagina %lld do Processo %d no Frame %d\n",
+                   (long long)tempo_atual, (long long)num_pag, pid, frame_substituicao);
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+        }
 
-        pag->presente = 1;
-        pag->frame = frame_substituicao;
-        pag->ultimo_acesso = tempo_atual; // Atualiza último acesso
-        sim->memoria.frames[frame_substituicao] = pid;
+        INSTR_INICIO(t_carga);
+        pag = entradaDeCarga(sim, pid, num_pag, pag, frame_substituicao);
+        if (carregaPagina(sim, frame_substituicao, proc, num_pag, pag))
+            sim->faltas_comprimidas++;
+        *pag |= PAG_REFERENCIADA | (escrita ? PAG_MODIFICADA : 0);
+        sim->memoria.tempo_carga[frame_substituicao] = tempo_atual;
+        sim->memoria.ultimo_acesso[frame_substituicao] = tempo_atual;
+        registraCarga(sim, algoritmo, frame_substituicao);
+        insereTLB(&sim->tlb, chave, frame_substituicao, 0);
+        if (observando(sim))
+            observaAcesso(sim, proc, num_pag, frame_substituicao, 1, escrita);
+        INSTR_FIM(FASE_CARGA, t_carga);
 
-        // Mostra estado da memória
-        imprimeEstadoMemoria(sim);
+        // Mostra estado da memória após substituição
+        if (sim->verbosidade >= VERBOSIDADE_COMPLETO) {
+            INSTR_INICIO(t_impressao);
+            imprimeEstadoMemoria(sim);
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+        }
     } else {
-        // Hit de página - atualiza tempo de acesso
-        printf("Tempo t=%d: [HIT] Pagina %d do Processo %d no Frame %d\n",
-               tempo_atual, num_pag, pid, pag->frame);
-        pag->ultimo_acesso = tempo_atual;
+        int frame = paginaFrame(*pag);
+        // Hit de página
+        if (sim->verbosidade >= VERBOSIDADE_COMPLETO) {
+            INSTR_INICIO(t_impressao);
+            printf("Tempo t=%lld: [HIT] Pagina %lld do Processo %d no Frame %d\n",
+                   (long long)tempo_atual, (long long)num_pag, pid, frame);
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+        }
+        INSTR_INICIO(t_hit);
+        // Os relógios só marcam R (e M); o LRU exato reordena a lista
+        *pag |= PAG_REFERENCIADA | (escrita ? PAG_MODIFICADA : 0);
+        if (frame_tlb < 0 && bloco_grande >= 0)
+            insereTLB(&sim->tlb, chavePagina(sim, pid, num_pag / sim->memoria.grandes.fator),
+                      bloco_grande * sim->memoria.grandes.fator, 1);
+        else if (frame_tlb < 0)
+            insereTLB(&sim->tlb, chave, frame, 0);
+        sim->memoria.uso_virtual[frame] = proc->acessos;
+        if (sim->memoria.grandes.blocos && sim->memoria.grandes.preenchida[frame])
+            usaPreenchida(sim, frame);
+        if (observando(sim))
+            observaAcesso(sim, proc, num_pag, frame, 0, escrita);
+        if (sim->memoria.pronta_ns[frame] >= 0) {
+            usaAntecipada(sim, frame, tempoDecorridoNs(sim));
+            gatilho = 2;
+        }
+        if (algoritmo == ALG_LRU) {
+            sim->memoria.ultimo_acesso[frame] = tempo_atual;
+            if (sim->memoria.lru_cabeca != frame) {
+                lruRemove(&sim->memoria, frame);
+                lruInsereCabeca(&sim->memoria, frame);
+            }
+        } else if (ehAdaptativo(algoritmo)) {
+            hitAdaptativo(&sim->memoria, algoritmo, frame);
+        } else if (algoritmo == ALG_OTIMO) {
+            atualizaOtimo(&sim->memoria, frame);
+        }
+        INSTR_FIM(FASE_HIT, t_hit);
     }
 
     // Calcula endereço físico
-    int endereco_fisico = (pag->frame * tam_pag) + desloc;
-    printf("Endereco Virtual: %d -> Endereco Fisico: %d\n", endereco_virtual, endereco_fisico);
-    printf("Detalhes: Pagina=%d, Desloc=%d, Frame=%d\n\n", num_pag, desloc, pag->frame);
-    
+    int64_t base = sim->bits_desloc >= 0 ? (int64_t)paginaFrame(*pag) << sim->bits_desloc
+                                         : (int64_t)paginaFrame(*pag) * sim->tamanho_pagina;
+    int64_t endereco_fisico = base + desloc;
+    if (sim->verbosidade >= VERBOSIDADE_COMPLETO) {
+        INSTR_INICIO(t_impressao);
+        printf("Endereco Virtual: %lld -> Endereco Fisico: %lld\n", (long long)endereco_virtual,
+               (long long)endereco_fisico);
+        printf("Detalhes: Pagina=%lld, Desloc=%lld, Frame=%d\n\n", (long long)num_pag,
+               (long long)desloc, paginaFrame(*pag));
+        if (algoritmo == ALG_FIFO) // Separador que só o FIFO sempre imprimiu
+            printf("................................................................\n\n");
+        INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+    }
+
+    // Por último: as páginas antecipadas podem expulsar a que acabou de ser usada
+    if (gatilho && sim->antecipacao.politica != ANTECIPA_NENHUMA && algoritmo != ALG_OTIMO)
+        antecipa(sim, proc, algoritmo, num_pag, gatilho == 1);
+    if (gatilho && grandesAtivas(sim))
+        promoveRegiao(sim, proc, algoritmo, num_pag);
+    encerraAcesso(sim, proc, gatilho == 1);
+    INSTR_FIM(FASE_TRADUCAO, t_traducao);
 
     return endereco_fisico;
-}
\ No newline at end of file
+}
+
+// Localiza o processo, prepara o algoritmo e traduz um acesso
+static int64_t traduzComAlgoritmo(Simulador *sim, int algoritmo, int pid, int64_t endereco_virtual,
+                                  int escrita) {
+    INSTR_INICIO(t_processo);
+    Processo *proc = buscaProcesso(sim, pid);
+    if (!proc) {
+        fprintf(stderr, "Processo %d nao encontrado!\n", pid);
+        return -1;
+    }
+    if (preparaTraducao(sim, algoritmo) != 0)
+        return -1;
+    INSTR_FIM(FASE_PROCESSO, t_processo);
+    return traduzAcesso(sim, algoritmo, proc, endereco_virtual, escrita);
+}
+
+// Tempo no disco em ns: leituras das faltas que a memória comprimida não atendeu e
+// gravações das páginas modificadas
+double tempoDiscoNs(const Simulador *sim) {
+    const LatenciasES *l = &sim->latencias;
+    return (sim->page_faults - sim->faltas_comprimidas) * l->falta +
+           sim->escritas_disco * l->escrita;
+}
+
+// Tempo na memória comprimida em ns: compressões (as rejeitadas também são tentadas)
+// e descompressões
+double tempoComprimidaNs(const Simulador *sim) {
+    const LatenciasES *l = &sim->latencias;
+    return (sim->comprimidas + sim->rejeitadas) * l->compressao +
+           sim->descomprimidas * l->descompressao;
+}
+
+// Tempo simulado em ns: memória em todo acesso, disco, memória comprimida e a espera
+// pelas leituras antecipadas atrasadas
+double tempoDecorridoNs(const Simulador *sim) {
+    return sim->total_acessos * sim->latencias.memoria + tempoDiscoNs(sim) +
+           tempoComprimidaNs(sim) + sim->espera_antecipacao_ns;
+}
+
+// Tempo efetivo de acesso em ns: tempo simulado dividido pelo número de acessos
+double tempoEfetivoAcesso(const Simulador *sim) {
+    if (sim->total_acessos == 0)
+        return 0.0;
+    return tempoDecorridoNs(sim) / (double)sim->total_acessos;
+}
+
+// Seleciona algoritmo para tradução de endereço (acesso de leitura)
+int64_t traduzEndereco(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzEnderecoOp(sim, pid, endereco_virtual, 'R');
+}
+
+// Traduz acesso de leitura ('R') ou escrita ('W'); escritas marcam a página como modificada
+int64_t traduzEnderecoOp(Simulador *sim, int pid, int64_t endereco_virtual, char op) {
+    if (sim->algoritmo < 0 || sim->algoritmo >= NUM_ALGORITMOS) {
+        printf("Algoritmo invalido!\n");
+        return -1;
+    }
+    return traduzComAlgoritmo(sim, sim->algoritmo, pid, endereco_virtual, op == 'W');
+}
+
+// Implementação do algoritmo FIFO
+int64_t traduzEnderecoFIFO(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_FIFO, pid, endereco_virtual, 0);
+}
+
+// Implementação do algoritmo LRU
+int64_t traduzEnderecoLRU(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_LRU, pid, endereco_virtual, 0);
+}
+
+// Implementação do algoritmo do relógio (CLOCK)
+int64_t traduzEnderecoClock(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_CLOCK, pid, endereco_virtual, 0);
+}
+
+// Implementação do algoritmo da segunda chance
+int64_t traduzEnderecoSegundaChance(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_SEGUNDA_CHANCE, pid, endereco_virtual, 0);
+}
+
+// Implementação do relógio melhorado (NRU com classes R/M)
+int64_t traduzEnderecoClockMelhorado(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_CLOCK_MELHORADO, pid, endereco_virtual, 0);
+}
+
+// Implementação do ARC (Adaptive Replacement Cache)
+int64_t traduzEnderecoARC(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_ARC, pid, endereco_virtual, 0);
+}
+
+// Implementação do 2Q
+int64_t traduzEndereco2Q(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_2Q, pid, endereco_virtual, 0);
+}
+
+// Implementação do LIRS
+int64_t traduzEnderecoLIRS(Simulador *sim, int pid, int64_t endereco_virtual) {
+    return traduzComAlgoritmo(sim, ALG_LIRS, pid, endereco_virtual, 0);
+}
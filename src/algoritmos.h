@@ -3,10 +3,38 @@
 
 #include "estruturas.h"
 
-int traduzEndereco(Simulador *sim, int pid, int endereco_virtual);
-int traduzEnderecoFIFO(Simulador *sim, int pid, int endereco_virtual);
-int traduzEnderecoLRU(Simulador *sim, int pid, int endereco_virtual);
+int64_t traduzEndereco(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoFIFO(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoLRU(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoClock(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoSegundaChance(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoClockMelhorado(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoARC(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEndereco2Q(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoLIRS(Simulador *sim, int pid, int64_t endereco_virtual);
+int64_t traduzEnderecoOp(Simulador *sim, int pid, int64_t endereco_virtual, char op);
+int preparaTraducao(Simulador *sim, int algoritmo);
+int64_t traduzAcesso(Simulador *sim, int algoritmo, Processo *proc, int64_t endereco_virtual,
+                     int escrita);
+void inicializarSimulador(Simulador *sim);
+void liberarSimulador(Simulador *sim);
 void reinicializarMemoria(Simulador *sim);
-
+int alocaMemoriaFisica(MemoriaFisica *mem, int num_frames);
+void liberaMemoriaFisica(MemoriaFisica *mem);
+int configuraMemoria(Simulador *sim, int tamanho_pagina, int64_t tamanho_memoria_fisica);
+const char *nomeAlgoritmo(int algoritmo);
+int algoritmoPorNome(const char *nome);
+int indicePorNome(const char *nome, const char *const *nomes, int n);
+Processo *buscaProcesso(const Simulador *sim, int pid);
+Processo *adicionaProcesso(Simulador *sim, int pid, int64_t num_paginas);
+int removeProcesso(Simulador *sim, int pid);
+int garantePaginas(Simulador *sim, Processo *proc, int64_t num_paginas);
+int liberaFramesOciosos(Simulador *sim, Processo *proc, int64_t limite, int motivo);
+int bitsDeslocamento(int tamanho_pagina);
+int bitsNumeroPagina(int tamanho_pagina);
+double tempoDiscoNs(const Simulador *sim);
+double tempoComprimidaNs(const Simulador *sim);
+double tempoDecorridoNs(const Simulador *sim);
+double tempoEfetivoAcesso(const Simulador *sim);
 
 #endif
@@ -0,0 +1,140 @@
+#include "alocacao.h"
+#include "adaptativos.h"
+#include "algoritmos.h"
+#include <stdlib.h>
+
+// Nomes dos modos, na ordem dos valores ALOCA_*
+static const char *nomes_modos[NUM_MODOS_ALOCACAO] = {
+    "global", "fixa", "proporcional", "ws", "pff"};
+
+// Retorna o nome do modo de alocação
+const char *nomeModoAlocacao(int modo) {
+    if (modo < 0 || modo >= NUM_MODOS_ALOCACAO)
+        return "?";
+    return nomes_modos[modo];
+}
+
+// Converte nome ou número do modo no valor ALOCA_*; -1 se inválido
+int modoAlocacaoPorNome(const char *nome) {
+    return indicePorNome(nome, nomes_modos, NUM_MODOS_ALOCACAO);
+}
+
+// A vítima restrita só existe nos algoritmos que varrem os frames; ARC, 2Q, LIRS e OPT
+// escolhem por estruturas próprias e ficam só com a alocação global
+int alocacaoSuportada(int modo, int algoritmo) {
+    return modo == ALOCA_GLOBAL || (!ehAdaptativo(algoritmo) && algoritmo != ALG_OTIMO);
+}
+
+// Troca o modo de alocação e recalcula as cotas. Retorna -1 se os parâmetros são inválidos
+int configuraAlocacao(Simulador *sim, const ParametrosAlocacao *parametros) {
+    if (parametros->modo < 0 || parametros->modo >= NUM_MODOS_ALOCACAO ||
+        parametros->janela < 1 || !(parametros->limiar_thrashing > 0.0) ||
+        parametros->limiar_thrashing > 1.0)
+        return -1;
+    sim->alocacao = *parametros;
+    recalculaCotas(sim);
+    return 0;
+}
+
+// Cota de cada processo: parte igual dos frames ou proporcional ao número de páginas.
+// No PFF é o ponto de partida; no working set é o tamanho atual do conjunto
+void recalculaCotas(Simulador *sim) {
+    int n = sim->num_processos;
+    int frames = sim->memoria.num_frames;
+    int64_t total_paginas = 0;
+    for (int i = 0; i < n; i++)
+        total_paginas += sim->processos[i].num_paginas;
+
+    for (int i = 0; i < n; i++) {
+        Processo *proc = &sim->processos[i];
+        if (sim->alocacao.modo == ALOCA_WORKING_SET)
+            proc->cota = proc->residentes;
+        else if (sim->alocacao.modo == ALOCA_PROPORCIONAL && total_paginas > 0)
+            proc->cota = (int)((double)frames * proc->num_paginas / total_paginas);
+        else
+            proc->cota = frames / n;
+        if (proc->cota < 1)
+            proc->cota = 1;
+    }
+}
+
+// Restrição da vítima para uma falta do processo sem frame livre. Com cota: quem já a
+// atingiu substitui as próprias páginas, quem está abaixo tira de quem a excedeu
+int restricaoVitima(const Simulador *sim, const Processo *proc) {
+    switch (sim->alocacao.modo) {
+        case ALOCA_FIXA:
+        case ALOCA_PROPORCIONAL:
+        case ALOCA_PFF:
+            return proc->residentes >= proc->cota ? VITIMA_DO_PROCESSO : VITIMA_EXCEDENTE;
+        case ALOCA_WORKING_SET:
+            return VITIMA_FORA_WS;
+    }
+    return VITIMA_QUALQUER;
+}
+
+// Indica se o frame pode ser vítima sob a restrição (frames livres sempre podem)
+int frameElegivel(const Simulador *sim, int frame, int restricao, int pid) {
+    const EntradaFrame *ef = &sim->memoria.frames[frame];
+    if (ef->pid == -1 || restricao == VITIMA_QUALQUER)
+        return 1;
+    if (restricao == VITIMA_DO_PROCESSO)
+        return ef->pid == pid;
+
+    const Processo *dono = buscaProcesso(sim, ef->pid);
+    if (!dono)
+        return 1;
+    if (restricao == VITIMA_EXCEDENTE)
+        return dono->residentes > dono->cota;
+    // Fora do working set: sem uso nos últimos janela acessos do dono
+    return sim->memoria.uso_virtual[frame] <= dono->acessos - sim->alocacao.janela;
+}
+
+// PFF, antes de buscar frame para a falta: faltas próximas (menos de janela acessos)
+// aumentam a cota; faltas espaçadas devolvem as páginas sem uso desde a última falta
+void ajustaAntesDaFalta(Simulador *sim, Processo *proc) {
+    if (sim->alocacao.modo != ALOCA_PFF)
+        return;
+    if (proc->acessos - proc->ultima_falta < sim->alocacao.janela) {
+        if (proc->cota < sim->memoria.num_frames)
+            proc->cota++;
+    } else {
+        liberaFramesOciosos(sim, proc, proc->ultima_falta, EXPULSAO_PFF);
+        proc->cota = proc->residentes + 1;
+    }
+    proc->ultima_falta = proc->acessos;
+}
+
+// Fim do acesso: conta a falta, apara o working set a cada janela acessos do processo
+// e fecha o intervalo da detecção de thrashing a cada janela acessos do simulador
+void encerraAcesso(Simulador *sim, Processo *proc, int falta) {
+    const ParametrosAlocacao *p = &sim->alocacao;
+    if (falta)
+        proc->faltas++;
+    if (p->modo == ALOCA_WORKING_SET && proc->acessos % p->janela == 0) {
+        liberaFramesOciosos(sim, proc, proc->acessos - p->janela, EXPULSAO_WORKING_SET);
+        proc->cota = proc->residentes;
+    }
+    // Thrashing: a maior parte dos acessos do intervalo faltou e expulsou uma página
+    if (sim->total_acessos % p->janela == 0) {
+        sim->intervalos++;
+        if ((double)sim->faltas_intervalo > p->limiar_thrashing * p->janela)
+            sim->intervalos_thrashing++;
+        sim->faltas_intervalo = 0;
+    }
+}
+
+// Páginas residentes do processo usadas nos últimos janela acessos dele
+int tamanhoWorkingSet(const Simulador *sim, const Processo *proc) {
+    int tamanho = 0;
+    for (int f = 0; f < sim->memoria.num_frames; f++) {
+        if (sim->memoria.frames[f].pid == proc->pid &&
+            sim->memoria.uso_virtual[f] > proc->acessos - sim->alocacao.janela)
+            tamanho++;
+    }
+    return tamanho;
+}
+
+// A simulação está em thrashing se a maioria dos intervalos encerrados passou do limiar
+int emThrashing(const Simulador *sim) {
+    return sim->intervalos > 0 && sim->intervalos_thrashing * 2 > sim->intervalos;
+}
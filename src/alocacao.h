@@ -0,0 +1,25 @@
+#ifndef ALOCACAO_H
+#define ALOCACAO_H
+
+#include "estruturas.h"
+
+// Restrição da vítima imposta pelo modo de alocação
+#define VITIMA_QUALQUER    0 // Qualquer frame (alocação global)
+#define VITIMA_DO_PROCESSO 1 // Só frames do processo que faltou
+#define VITIMA_EXCEDENTE   2 // Só frames de processos acima da cota
+#define VITIMA_FORA_WS     3 // Só páginas fora do working set do dono
+
+// Alocação de frames por processo: cotas, working set, PFF e detecção de thrashing
+const char *nomeModoAlocacao(int modo);
+int modoAlocacaoPorNome(const char *nome);
+int alocacaoSuportada(int modo, int algoritmo);
+int configuraAlocacao(Simulador *sim, const ParametrosAlocacao *parametros);
+void recalculaCotas(Simulador *sim);
+int restricaoVitima(const Simulador *sim, const Processo *proc);
+int frameElegivel(const Simulador *sim, int frame, int restricao, int pid);
+void ajustaAntesDaFalta(Simulador *sim, Processo *proc);
+void encerraAcesso(Simulador *sim, Processo *proc, int falta);
+int tamanhoWorkingSet(const Simulador *sim, const Processo *proc);
+int emThrashing(const Simulador *sim);
+
+#endif
@@ -0,0 +1,101 @@
+#include "antecipacao.h"
+#include "algoritmos.h"
+#include <stdlib.h>
+
+// Nomes das políticas, na ordem dos valores ANTECIPA_*
+static const char *nomes_politicas[NUM_POLITICAS_ANTECIPACAO] = {
+    "nenhuma", "sequencial", "passo", "adaptativa"};
+
+// Retorna o nome da política de leitura antecipada
+const char *nomePoliticaAntecipacao(int politica) {
+    if (politica < 0 || politica >= NUM_POLITICAS_ANTECIPACAO)
+        return "?";
+    return nomes_politicas[politica];
+}
+
+// Converte nome ou número da política no valor ANTECIPA_*; -1 se inválido
+int politicaAntecipacaoPorNome(const char *nome) {
+    return indicePorNome(nome, nomes_politicas, NUM_POLITICAS_ANTECIPACAO);
+}
+
+// Troca a política; o fluxo de cada processo recomeça. Retorna -1 se inválida
+int configuraAntecipacao(Simulador *sim, const ParametrosAntecipacao *parametros) {
+    if (parametros->politica < 0 || parametros->politica >= NUM_POLITICAS_ANTECIPACAO ||
+        parametros->paginas < 1 || parametros->paginas > ANTECIPA_PAGINAS_MAX)
+        return -1;
+    sim->antecipacao = *parametros;
+    for (int i = 0; i < sim->num_processos; i++)
+        reiniciaFluxo(&sim->processos[i]);
+    return 0;
+}
+
+// Esquece o fluxo de acessos do processo
+void reiniciaFluxo(Processo *proc) {
+    proc->ultima_pagina = -1;
+    proc->passo = 0;
+    proc->janela = 0;
+}
+
+// Gatilho na página num_pag (falta ou primeiro uso de página antecipada): atualiza o
+// fluxo do processo e grava em paginas as candidatas a carregar; retorna quantas são
+int paginasAntecipar(Simulador *sim, Processo *proc, int64_t num_pag, int64_t *paginas) {
+    const ParametrosAntecipacao *p = &sim->antecipacao;
+    int64_t delta = proc->ultima_pagina >= 0 ? num_pag - proc->ultima_pagina : 0;
+    proc->ultima_pagina = num_pag;
+
+    int64_t passo = 1;
+    int quantidade = 0;
+    switch (p->politica) {
+        case ANTECIPA_SEQUENCIAL:
+            quantidade = p->paginas;
+            break;
+        case ANTECIPA_PASSO:
+            // O passo só vale depois de se repetir em dois gatilhos seguidos
+            if (delta != 0 && delta == proc->passo) {
+                passo = delta;
+                quantidade = p->paginas;
+            }
+            proc->passo = delta;
+            break;
+        case ANTECIPA_ADAPTATIVA:
+            // Fluxo sequencial dobra a janela; acesso fora dele a fecha
+            if (delta == 1)
+                proc->janela = proc->janela ? proc->janela * 2 : 1;
+            else
+                proc->janela = 0;
+            if (proc->janela > p->paginas)
+                proc->janela = p->paginas;
+            quantidade = proc->janela;
+            break;
+    }
+
+    // Metade dos frames no máximo, para a leitura não expulsar a página pedida
+    int limite = sim->memoria.num_frames / 2;
+    if (quantidade > limite)
+        quantidade = limite;
+    for (int k = 0; k < quantidade; k++)
+        paginas[k] = num_pag + passo * (k + 1);
+    return quantidade;
+}
+
+// Primeiro acesso a uma página antecipada: útil, e atrasada se a leitura não acabou
+void usaAntecipada(Simulador *sim, int frame, double agora_ns) {
+    double pronta = sim->memoria.pronta_ns[frame];
+    sim->memoria.pronta_ns[frame] = -1.0;
+    sim->antecipadas_uteis++;
+    if (pronta > agora_ns) {
+        sim->antecipadas_atrasadas++;
+        sim->espera_antecipacao_ns += pronta - agora_ns;
+    }
+}
+
+// A página antecipada do frame saiu sem ser usada: na adaptativa a janela cai à metade
+void descartaAntecipada(Simulador *sim, int frame) {
+    sim->memoria.pronta_ns[frame] = -1.0;
+    sim->antecipadas_desperdicadas++;
+    if (sim->antecipacao.politica == ANTECIPA_ADAPTATIVA) {
+        Processo *proc = buscaProcesso(sim, sim->memoria.frames[frame].pid);
+        if (proc)
+            proc->janela /= 2;
+    }
+}
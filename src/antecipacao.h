@@ -0,0 +1,15 @@
+#ifndef ANTECIPACAO_H
+#define ANTECIPACAO_H
+
+#include "estruturas.h"
+
+// Leitura antecipada: escolhe as páginas a carregar junto com uma falta
+const char *nomePoliticaAntecipacao(int politica);
+int politicaAntecipacaoPorNome(const char *nome);
+int configuraAntecipacao(Simulador *sim, const ParametrosAntecipacao *parametros);
+void reiniciaFluxo(Processo *proc);
+int paginasAntecipar(Simulador *sim, Processo *proc, int64_t num_pag, int64_t *paginas);
+void usaAntecipada(Simulador *sim, int frame, double agora_ns);
+void descartaAntecipada(Simulador *sim, int frame);
+
+#endif
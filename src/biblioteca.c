@@ -0,0 +1,141 @@
+#include "biblioteca.h"
+#include "algoritmos.h"
+#include "alocacao.h"
+#include "tabela_paginas.h"
+#include "tlb.h"
+#include <stdlib.h>
+
+struct SimuladorPaginacao
+{
+    Simulador sim;
+};
+
+// Hits somados dos dois níveis: um hit na L2 também poupa a tabela de páginas
+static int64_t hitsTLB(const TLB *tlb) {
+    return tlb->nivel[0].hits + tlb->nivel[1].hits;
+}
+
+// Cria o simulador sem saída no terminal; NULL com parâmetros inválidos ou sem memória
+SimuladorPaginacao *simCria(const ParametrosSimulador *parametros) {
+    SimuladorPaginacao *s = malloc(sizeof(SimuladorPaginacao));
+    if (!s)
+        return NULL;
+    Simulador *sim = &s->sim;
+    inicializarSimulador(sim);
+    sim->verbosidade = VERBOSIDADE_SILENCIOSO;
+    if (!parametros)
+        return s;
+
+    int ok = 1;
+    int tam_pagina = parametros->tamanho_pagina > 0 ? parametros->tamanho_pagina
+                                                    : sim->tamanho_pagina;
+    int64_t tam_memoria = parametros->tamanho_memoria > 0 ? parametros->tamanho_memoria
+                                                          : sim->tamanho_memoria_fisica;
+    if (configuraMemoria(sim, tam_pagina, tam_memoria) != 0)
+        ok = 0;
+    if (ok && parametros->algoritmo) {
+        sim->algoritmo = algoritmoPorNome(parametros->algoritmo);
+        // Sem trace não há futuro para o OPT consultar
+        if (sim->algoritmo < 0 || sim->algoritmo == ALG_OTIMO)
+            ok = 0;
+    }
+    if (ok && parametros->tabela) {
+        int modo = modoTabelaPorNome(parametros->tabela);
+        if (modo < 0 || configuraTabela(sim, modo, sim->niveis) != 0)
+            ok = 0;
+    }
+    if (ok && parametros->tlb_conjuntos > 0) {
+        int conjuntos2 = parametros->tlb2_conjuntos > 0 ? parametros->tlb2_conjuntos : 0;
+        ParametrosTLB p = {{parametros->tlb_conjuntos, conjuntos2},
+                           {parametros->tlb_vias > 0 ? parametros->tlb_vias : 1,
+                            parametros->tlb2_vias > 0 ? parametros->tlb2_vias : 1},
+                           TLB_LRU, 1};
+        if (configuraTLB(&sim->tlb, &p) != 0)
+            ok = 0;
+    }
+    if (ok && parametros->alocacao) {
+        ParametrosAlocacao p = sim->alocacao;
+        p.modo = modoAlocacaoPorNome(parametros->alocacao);
+        if (p.modo < 0 || !alocacaoSuportada(p.modo, sim->algoritmo) ||
+            configuraAlocacao(sim, &p) != 0)
+            ok = 0;
+    }
+    if (!ok) {
+        simDestroi(s);
+        return NULL;
+    }
+    return s;
+}
+
+void simDestroi(SimuladorPaginacao *s) {
+    if (!s)
+        return;
+    liberarSimulador(&s->sim);
+    free(s);
+}
+
+// Adiciona o processo com espaço de tamanho bytes (arredondado para páginas inteiras)
+int simAdicionaProcesso(SimuladorPaginacao *s, int pid, int64_t tamanho) {
+    Simulador *sim = &s->sim;
+    if (pid < 0 || tamanho <= 0 || buscaProcesso(sim, pid))
+        return -1;
+    int64_t paginas = (tamanho + sim->tamanho_pagina - 1) / sim->tamanho_pagina;
+    return adicionaProcesso(sim, pid, paginas) ? 0 : -1;
+}
+
+int simRemoveProcesso(SimuladorPaginacao *s, int pid) {
+    return removeProcesso(&s->sim, pid);
+}
+
+// Traduz o lote com o algoritmo preparado uma vez e o processo do acesso anterior
+// reaproveitado; os bits de cada resultado saem dos contadores antes e depois
+int64_t simTraduzLote(SimuladorPaginacao *s, const int *pids, const int64_t *enderecos,
+                      const char *ops, int64_t n, int64_t *fisicos, uint8_t *resultados) {
+    Simulador *sim = &s->sim;
+    if (n <= 0 || preparaTraducao(sim, sim->algoritmo) != 0)
+        return 0;
+
+    Processo *proc = NULL;
+    for (int64_t i = 0; i < n; i++) {
+        if (!proc || proc->pid != pids[i]) {
+            proc = buscaProcesso(sim, pids[i]);
+            if (!proc)
+                return i;
+        }
+        if (enderecos[i] < 0 || paginaDoEndereco(sim, enderecos[i]) >= proc->num_paginas ||
+            (ops[i] != 'R' && ops[i] != 'W'))
+            return i;
+
+        int64_t faltas = sim->page_faults;
+        int64_t escritas = sim->escritas_disco;
+        int64_t hits_tlb = hitsTLB(&sim->tlb);
+        int64_t fisico = traduzAcesso(sim, sim->algoritmo, proc, enderecos[i], ops[i] == 'W');
+        if (fisico < 0)
+            return i;
+
+        if (fisicos)
+            fisicos[i] = fisico;
+        if (resultados) {
+            uint8_t r = 0;
+            if (sim->page_faults != faltas)
+                r |= SIM_FALTA;
+            if (hitsTLB(&sim->tlb) != hits_tlb)
+                r |= SIM_TLB;
+            if (sim->escritas_disco != escritas)
+                r |= SIM_GRAVOU;
+            resultados[i] = r;
+        }
+    }
+    return n;
+}
+
+void simContadores(const SimuladorPaginacao *s, ContadoresSimulador *contadores) {
+    const Simulador *sim = &s->sim;
+    contadores->acessos = sim->total_acessos;
+    contadores->faltas = sim->page_faults;
+    contadores->escritas_disco = sim->escritas_disco;
+    contadores->hits_tlb = hitsTLB(&sim->tlb);
+    contadores->misses_tlb = sim->tlb.parametros.conjuntos[1] > 0 ? sim->tlb.nivel[1].misses
+                                                                 : sim->tlb.nivel[0].misses;
+    contadores->tempo_efetivo_ns = tempoEfetivoAcesso(sim);
+}
@@ -0,0 +1,58 @@
+#ifndef BIBLIOTECA_H
+#define BIBLIOTECA_H
+
+#include <stdint.h>
+
+// Interface para embutir o simulador em outro programa: não escreve nada na saída
+// padrão e traduz acessos em lotes. O estado fica escondido atrás do ponteiro
+typedef struct SimuladorPaginacao SimuladorPaginacao;
+
+// Parâmetros de criação; zero ou NULL mantém o padrão do simulador
+typedef struct
+{
+    int tamanho_pagina;      // Bytes
+    int64_t tamanho_memoria; // Bytes de memória física
+    const char *algoritmo;   // "fifo", "lru", "clock", "arc", ... (o OPT exige um trace)
+    const char *tabela;      // "linear", "multinivel" ou "invertida"
+    int tlb_conjuntos;       // TLB L1 (0 = sem TLB)
+    int tlb_vias;
+    const char *alocacao;    // "global", "fixa", "proporcional", "ws" ou "pff"
+    int tlb2_conjuntos;      // TLB L2 (0 = só a L1)
+    int tlb2_vias;
+} ParametrosSimulador;
+
+// Resultado de cada acesso do lote (bits combinados)
+#define SIM_FALTA  0x1 // Page fault: a página não estava na memória
+#define SIM_TLB    0x2 // Traduzido pela TLB (L1 ou L2), sem consultar a tabela de páginas
+#define SIM_GRAVOU 0x4 // A falta gravou no disco uma página modificada que saiu
+
+// Contadores acumulados desde a criação
+typedef struct
+{
+    int64_t acessos;
+    int64_t faltas;
+    int64_t escritas_disco;
+    int64_t hits_tlb;   // Hits na L1 ou na L2
+    int64_t misses_tlb; // Traduções que passaram por todos os níveis sem achar a página
+    double tempo_efetivo_ns; // Tempo efetivo de acesso médio
+} ContadoresSimulador;
+
+// Cria o simulador; NULL com parâmetros inválidos ou sem memória
+SimuladorPaginacao *simCria(const ParametrosSimulador *parametros);
+void simDestroi(SimuladorPaginacao *s);
+
+// Processos com espaço de endereçamento de tamanho bytes; 0 ou -1 em erro
+int simAdicionaProcesso(SimuladorPaginacao *s, int pid, int64_t tamanho);
+int simRemoveProcesso(SimuladorPaginacao *s, int pid);
+
+// Traduz n acessos (pid, endereço virtual, 'R' ou 'W'). Preenche fisicos[i] com o
+// endereço físico e resultados[i] com os bits SIM_* (qualquer um dos dois pode ser
+// NULL). Retorna quantos acessos foram traduzidos: menos que n indica que o acesso
+// seguinte tem processo desconhecido, endereço fora do espaço, operação inválida ou
+// que faltou memória, e ele não foi simulado
+int64_t simTraduzLote(SimuladorPaginacao *s, const int *pids, const int64_t *enderecos,
+                      const char *ops, int64_t n, int64_t *fisicos, uint8_t *resultados);
+
+void simContadores(const SimuladorPaginacao *s, ContadoresSimulador *contadores);
+
+#endif
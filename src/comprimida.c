@@ -0,0 +1,254 @@
+#include "comprimida.h"
+#include "algoritmos.h"
+#include "instrumentacao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COMPRIMIDA_POSICOES_INICIAIS 1024
+
+// Lê a distribuição das razões de compressão: "R" (todas as páginas com a razão R)
+// ou "R:P,R:P,..." (razão R com peso P; os pesos são normalizados). Retorna -1 se inválida
+int leRazoesCompressao(const char *texto, ParametrosComprimida *parametros) {
+    ParametrosComprimida *p = parametros;
+    double total = 0.0;
+    const char *c = texto;
+    p->num_razoes = 0;
+    for (;;) {
+        char *fim;
+        double razao = strtod(c, &fim);
+        double peso = 1.0;
+        if (fim == c || !(razao > 0.0) || p->num_razoes == COMPRIMIDA_RAZOES_MAX)
+            return -1;
+        c = fim;
+        if (*c == ':') {
+            peso = strtod(c + 1, &fim);
+            if (fim == c + 1 || !(peso > 0.0))
+                return -1;
+            c = fim;
+        }
+        p->razoes[p->num_razoes] = razao;
+        total += peso;
+        p->acumuladas[p->num_razoes++] = total;
+        if (*c == '\0')
+            break;
+        if (*c++ != ',')
+            return -1;
+    }
+    for (int k = 0; k < p->num_razoes; k++)
+        p->acumuladas[k] /= total;
+    return 0;
+}
+
+// Troca capacidade e distribuição; o pool é descartado e a memória esvaziada. Retorna
+// -1 se os parâmetros forem inválidos (capacidade 0 desliga a memória comprimida)
+int configuraComprimida(Simulador *sim, const ParametrosComprimida *parametros) {
+    const ParametrosComprimida *p = parametros;
+    if (p->capacidade < 0 || p->num_razoes < 1 || p->num_razoes > COMPRIMIDA_RAZOES_MAX)
+        return -1;
+    for (int k = 0; k < p->num_razoes; k++) {
+        if (!(p->razoes[k] > 0.0) || p->acumuladas[k] < (k ? p->acumuladas[k - 1] : 0.0))
+            return -1;
+    }
+    liberaComprimida(&sim->memoria);
+    sim->comprimida = *p;
+    reinicializarMemoria(sim);
+    return 0;
+}
+
+// Razão esperada da distribuição (média ponderada pelos pesos)
+double razaoMediaCompressao(const ParametrosComprimida *parametros) {
+    double media = 0.0, anterior = 0.0;
+    for (int k = 0; k < parametros->num_razoes; k++) {
+        media += parametros->razoes[k] * (parametros->acumuladas[k] - anterior);
+        anterior = parametros->acumuladas[k];
+    }
+    return media;
+}
+
+// Razão de compressão da página: sorteada pela chave, então a mesma página sempre
+// comprime igual e a simulação é reproduzível
+static double razaoDaPagina(const Simulador *sim, int pid, int64_t pagina) {
+    const ParametrosComprimida *p = &sim->comprimida;
+    uint64_t x = chavePagina(sim, pid, pagina) + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    double u = (double)(x >> 11) / 9007199254740992.0; // Uniforme em [0, 1)
+    for (int k = 0; k < p->num_razoes - 1; k++) {
+        if (u < p->acumuladas[k])
+            return p->razoes[k];
+    }
+    return p->razoes[p->num_razoes - 1];
+}
+
+// Aloca o pool no primeiro uso
+static int preparaComprimida(MemoriaFisica *mem) {
+    EstadoComprimida *c = &mem->comprimida;
+    if (c->entradas)
+        return 0;
+    c->entradas = malloc(COMPRIMIDA_POSICOES_INICIAIS * sizeof(EntradaComprimida));
+    c->livres = malloc(COMPRIMIDA_POSICOES_INICIAIS * sizeof(int));
+    if (!c->entradas || !c->livres || mapaInicializa(&c->indice, 16) != 0) {
+        liberaComprimida(mem);
+        return -1;
+    }
+    c->capacidade = COMPRIMIDA_POSICOES_INICIAIS;
+    reiniciaComprimida(mem);
+    return 0;
+}
+
+// Dobra as posições do pool; as novas entram na pilha de livres
+static int cresceComprimida(EstadoComprimida *c) {
+    int nova = 2 * c->capacidade;
+    EntradaComprimida *entradas = realloc(c->entradas, nova * sizeof(EntradaComprimida));
+    if (!entradas)
+        return -1;
+    c->entradas = entradas;
+    int *livres = realloc(c->livres, nova * sizeof(int));
+    if (!livres)
+        return -1;
+    c->livres = livres;
+    for (int i = nova - 1; i >= c->capacidade; i--) {
+        c->entradas[i].pid = -1;
+        c->livres[c->num_livres++] = i;
+    }
+    c->capacidade = nova;
+    return 0;
+}
+
+// Tira a entrada do pool e devolve a posição à pilha de livres
+static void removeEntrada(const Simulador *sim, EstadoComprimida *c, int pos) {
+    EntradaComprimida *e = &c->entradas[pos];
+    if (e->ant != -1)
+        c->entradas[e->ant].prox = e->prox;
+    else
+        c->cabeca = e->prox;
+    if (e->prox != -1)
+        c->entradas[e->prox].ant = e->ant;
+    else
+        c->cauda = e->ant;
+    mapaRemove(&c->indice, chavePagina(sim, e->pid, e->pagina));
+    c->bytes -= e->bytes;
+    c->num_paginas--;
+    e->pid = -1;
+    c->livres[c->num_livres++] = pos;
+}
+
+// Devolve ao disco a página mais antiga do pool, gravando-a se o disco não a tem
+static void devolveMaisAntiga(Simulador *sim) {
+    EstadoComprimida *c = &sim->memoria.comprimida;
+    const EntradaComprimida *e = &c->entradas[c->cauda];
+    if (e->modificada) {
+        sim->escritas_disco++;
+        sim->devolvidas_gravadas++;
+        if (sim->verbosidade >= VERBOSIDADE_FALTAS) {
+            INSTR_INICIO(t_impressao);
+            printf("Tempo t=%lld: Gravando Pagina %lld do Processo %d (saiu da memoria "
+                   "comprimida)\n", (long long)sim->tempo_atual - 1, (long long)e->pagina,
+                   e->pid);
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+        }
+    }
+    sim->devolvidas++;
+    removeEntrada(sim, c, c->cauda);
+}
+
+// Comprime a página que está saindo do frame para o pool, abrindo espaço com as mais
+// antigas dele. Retorna -1 se ela não comprime o bastante, não cabe ou faltou memória:
+// nesse caso ela segue para o disco como sem a memória comprimida
+int guardaComprimida(Simulador *sim, int frame, int modificada) {
+    EstadoComprimida *c = &sim->memoria.comprimida;
+    const EntradaFrame *ef = &sim->memoria.frames[frame];
+    double razao = razaoDaPagina(sim, ef->pid, ef->pagina);
+    double exato = sim->tamanho_pagina / razao;
+    int64_t bytes = (int64_t)exato;
+    if (bytes < exato)
+        bytes++; // Arredonda para cima
+    if (razao <= 1.0 || bytes > sim->comprimida.capacidade ||
+        preparaComprimida(&sim->memoria) != 0 ||
+        (c->num_livres == 0 && cresceComprimida(c) != 0)) {
+        sim->rejeitadas++;
+        return -1;
+    }
+    int pos = c->livres[c->num_livres - 1];
+    if (mapaInsere(&c->indice, chavePagina(sim, ef->pid, ef->pagina), pos) != 0) {
+        sim->rejeitadas++;
+        return -1;
+    }
+    c->num_livres--;
+    while (c->bytes + bytes > sim->comprimida.capacidade)
+        devolveMaisAntiga(sim);
+
+    EntradaComprimida *e = &c->entradas[pos];
+    e->pid = ef->pid;
+    e->pagina = ef->pagina;
+    e->bytes = (int)bytes;
+    e->modificada = modificada;
+    e->ant = -1;
+    e->prox = c->cabeca;
+    if (c->cabeca != -1)
+        c->entradas[c->cabeca].ant = pos;
+    else
+        c->cauda = pos;
+    c->cabeca = pos;
+    c->bytes += bytes;
+    c->num_paginas++;
+    if (c->bytes > sim->pico_comprimida)
+        sim->pico_comprimida = c->bytes;
+    sim->comprimidas++;
+    return 0;
+}
+
+// Descomprime a página que vai ser carregada, se ela está no pool, e a tira de lá.
+// Retorna -1 se ela não está no pool; senão, 1 se o disco não tem a versão atual
+// (a página volta modificada) e 0 se tem
+int retiraComprimida(Simulador *sim, int pid, int64_t pagina) {
+    EstadoComprimida *c = &sim->memoria.comprimida;
+    int64_t pos;
+    if (!c->entradas || !mapaBusca(&c->indice, chavePagina(sim, pid, pagina), &pos))
+        return -1;
+    int modificada = c->entradas[pos].modificada;
+    removeEntrada(sim, c, (int)pos);
+    sim->descomprimidas++;
+    return modificada;
+}
+
+// Descarta as páginas do processo removido
+void esqueceProcessoComprimida(Simulador *sim, int pid) {
+    EstadoComprimida *c = &sim->memoria.comprimida;
+    if (!c->entradas)
+        return;
+    for (int pos = c->cabeca; pos != -1;) {
+        int prox = c->entradas[pos].prox;
+        if (c->entradas[pos].pid == pid)
+            removeEntrada(sim, c, pos);
+        pos = prox;
+    }
+}
+
+// Esvazia o pool
+void reiniciaComprimida(MemoriaFisica *mem) {
+    EstadoComprimida *c = &mem->comprimida;
+    if (!c->entradas)
+        return;
+    c->num_livres = 0;
+    for (int i = c->capacidade - 1; i >= 0; i--) {
+        c->entradas[i].pid = -1;
+        c->livres[c->num_livres++] = i;
+    }
+    c->cabeca = c->cauda = -1;
+    c->num_paginas = 0;
+    c->bytes = 0;
+    mapaLimpa(&c->indice);
+}
+
+// Libera o pool (volta a ser montado na próxima página guardada)
+void liberaComprimida(MemoriaFisica *mem) {
+    EstadoComprimida *c = &mem->comprimida;
+    free(c->entradas);
+    free(c->livres);
+    mapaLibera(&c->indice);
+    memset(c, 0, sizeof(EstadoComprimida));
+    c->cabeca = c->cauda = -1;
+}
@@ -0,0 +1,19 @@
+#ifndef COMPRIMIDA_H
+#define COMPRIMIDA_H
+
+#include "estruturas.h"
+
+// Memória comprimida ligada na configuração (o pool é montado na primeira página guardada)
+#define comprimidaAtiva(sim) ((sim)->comprimida.capacidade > 0)
+
+// Memória comprimida entre a RAM e o disco (zswap)
+int leRazoesCompressao(const char *texto, ParametrosComprimida *parametros);
+int configuraComprimida(Simulador *sim, const ParametrosComprimida *parametros);
+int guardaComprimida(Simulador *sim, int frame, int modificada);
+int retiraComprimida(Simulador *sim, int pid, int64_t pagina);
+void esqueceProcessoComprimida(Simulador *sim, int pid);
+void reiniciaComprimida(MemoriaFisica *mem);
+void liberaComprimida(MemoriaFisica *mem);
+double razaoMediaCompressao(const ParametrosComprimida *parametros);
+
+#endif
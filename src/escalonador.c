@@ -0,0 +1,59 @@
+#include "escalonador.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Libera os traces já carregados e o vetor de tamanhos
+static void liberaTraces(AcessoTrace **traces, int64_t *tamanhos, int num_traces) {
+    for (int i = 0; traces && i < num_traces; i++)
+        free(traces[i]);
+    free(traces);
+    free(tamanhos);
+}
+
+// Carrega um trace por processo (o i-ésimo vira o processo i+1, qualquer que seja o pid
+// gravado) e os intercala em rodízio, quantum acessos de cada vez. Retorna o total de
+// acessos em *acessos ou -1 em erro
+int64_t intercalaTraces(const char *const *caminhos, int num_traces, int quantum,
+                        AcessoTrace **acessos) {
+    *acessos = NULL;
+    if (num_traces < 1 || quantum < 1)
+        return -1;
+    AcessoTrace **traces = calloc(num_traces, sizeof(AcessoTrace *));
+    // Tamanho de cada trace seguido da posição do próximo acesso a copiar
+    int64_t *tamanhos = calloc(2 * (size_t)num_traces, sizeof(int64_t));
+    if (!traces || !tamanhos) {
+        liberaTraces(traces, tamanhos, num_traces);
+        return -1;
+    }
+
+    int64_t soma = 0;
+    for (int i = 0; i < num_traces; i++) {
+        tamanhos[i] = carregaTrace(caminhos[i], &traces[i]);
+        if (tamanhos[i] < 0) {
+            fprintf(stderr, "Erro ao ler o trace %s!\n", caminhos[i]);
+            liberaTraces(traces, tamanhos, num_traces);
+            return -1;
+        }
+        soma += tamanhos[i];
+    }
+    AcessoTrace *saida = malloc((size_t)(soma > 0 ? soma : 1) * sizeof(AcessoTrace));
+    if (!saida) {
+        liberaTraces(traces, tamanhos, num_traces);
+        return -1;
+    }
+
+    // Cada volta dá um quantum a cada processo que ainda tem acessos
+    int64_t *posicoes = tamanhos + num_traces;
+    int64_t total = 0;
+    while (total < soma) {
+        for (int i = 0; i < num_traces; i++) {
+            for (int k = 0; k < quantum && posicoes[i] < tamanhos[i]; k++) {
+                saida[total] = traces[i][posicoes[i]++];
+                saida[total++].pid = i + 1;
+            }
+        }
+    }
+    liberaTraces(traces, tamanhos, num_traces);
+    *acessos = saida;
+    return total;
+}
@@ -0,0 +1,12 @@
+#ifndef ESCALONADOR_H
+#define ESCALONADOR_H
+
+#include "trace.h"
+
+#define QUANTUM_PADRAO 100 // Acessos seguidos de cada processo por vez
+
+// Escalonamento round-robin dos traces de vários processos num único fluxo de acessos
+int64_t intercalaTraces(const char *const *caminhos, int num_traces, int quantum,
+                        AcessoTrace **acessos);
+
+#endif
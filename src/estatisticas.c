@@ -0,0 +1,327 @@
+#include "estatisticas.h"
+#include "algoritmos.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Nomes dos motivos, na ordem dos valores EXPULSAO_*
+static const char *nomes_motivos[NUM_MOTIVOS_EXPULSAO] = {
+    "substituicao", "antecipacao", "working_set", "pff", "processo"};
+
+// Retorna o nome do motivo de expulsão
+const char *nomeMotivoExpulsao(int motivo) {
+    if (motivo < 0 || motivo >= NUM_MOTIVOS_EXPULSAO)
+        return "?";
+    return nomes_motivos[motivo];
+}
+
+// Libera os vetores por frame e a série
+static void liberaVetores(Estatisticas *e) {
+    free(e->cargas_frame);
+    free(e->hits_frame);
+    free(e->expulsoes_frame);
+    free(e->serie);
+    e->cargas_frame = e->hits_frame = e->expulsoes_frame = e->serie = NULL;
+    e->num_frames = 0;
+}
+
+// Liga as estatísticas detalhadas com pontos de janela acessos na série. Retorna -1
+// se a janela é inválida ou falta memória
+int ativaEstatisticas(Simulador *sim, int janela) {
+    if (janela < 1)
+        return -1;
+    if (!sim->estatisticas && !(sim->estatisticas = calloc(1, sizeof(Estatisticas))))
+        return -1;
+    sim->estatisticas->janela = janela;
+    reiniciaEstatisticas(sim);
+    if (sim->estatisticas->num_frames != sim->memoria.num_frames) {
+        desativaEstatisticas(sim);
+        return -1;
+    }
+    return 0;
+}
+
+// Zera os contadores (e acompanha mudanças no número de frames)
+void reiniciaEstatisticas(Simulador *sim) {
+    Estatisticas *e = sim->estatisticas;
+    if (!e)
+        return;
+    int frames = sim->memoria.num_frames;
+    if (e->num_frames != frames) {
+        liberaVetores(e);
+        e->cargas_frame = calloc(frames, sizeof(int64_t));
+        e->hits_frame = calloc(frames, sizeof(int64_t));
+        e->expulsoes_frame = calloc(frames, sizeof(int64_t));
+        if (!e->cargas_frame || !e->hits_frame || !e->expulsoes_frame)
+            liberaVetores(e); // num_frames fica 0: os ganchos deixam de contar por frame
+        else
+            e->num_frames = frames;
+    } else if (frames > 0) {
+        memset(e->cargas_frame, 0, frames * sizeof(int64_t));
+        memset(e->hits_frame, 0, frames * sizeof(int64_t));
+        memset(e->expulsoes_frame, 0, frames * sizeof(int64_t));
+    }
+    memset(e->intervalo_faltas, 0, sizeof(e->intervalo_faltas));
+    memset(e->expulsoes, 0, sizeof(e->expulsoes));
+    memset(e->expulsoes_modificadas, 0, sizeof(e->expulsoes_modificadas));
+    e->ultima_falta = 0;
+    e->tamanho_serie = 0;
+    for (int i = 0; i < sim->num_processos; i++)
+        sim->processos[i].expulsas = 0;
+}
+
+// Desliga as estatísticas detalhadas
+void desativaEstatisticas(Simulador *sim) {
+    if (!sim->estatisticas)
+        return;
+    liberaVetores(sim->estatisticas);
+    free(sim->estatisticas);
+    sim->estatisticas = NULL;
+}
+
+// Abre o log de eventos em caminho e grava o cabeçalho. Retorna -1 em erro
+int abreLogEventos(Simulador *sim, const char *caminho) {
+    LogEventos *log = calloc(1, sizeof(LogEventos));
+    if (!log)
+        return -1;
+    log->buffer = malloc(EVENTOS_BUFFER * sizeof(RegistroEvento));
+    log->arquivo = fopen(caminho, "wb");
+    CabecalhoEventos cab = {{'P', 'G', 'E', 'V'}, EVENTOS_VERSAO, 0};
+    if (!log->buffer || !log->arquivo || fwrite(&cab, sizeof(cab), 1, log->arquivo) != 1) {
+        fprintf(stderr, "Erro ao criar o log de eventos %s\n", caminho);
+        if (log->arquivo)
+            fclose(log->arquivo);
+        free(log->buffer);
+        free(log);
+        return -1;
+    }
+    fechaLogEventos(sim); // Um log anterior é encerrado
+    sim->eventos = log;
+    return 0;
+}
+
+// Grava os registros acumulados no buffer
+static void despejaEventos(LogEventos *log) {
+    if (log->usados > 0 &&
+        fwrite(log->buffer, sizeof(RegistroEvento), log->usados, log->arquivo) != (size_t)log->usados)
+        log->erro = 1;
+    log->gravados += log->usados;
+    log->usados = 0;
+}
+
+// Grava o restante do buffer e fecha o log. Retorna -1 se alguma gravação falhou
+int fechaLogEventos(Simulador *sim) {
+    LogEventos *log = sim->eventos;
+    if (!log)
+        return 0;
+    despejaEventos(log);
+    if (fclose(log->arquivo) != 0)
+        log->erro = 1;
+    int status = log->erro ? -1 : 0;
+    free(log->buffer);
+    free(log);
+    sim->eventos = NULL;
+    return status;
+}
+
+// Acrescenta um evento ao buffer do log
+static void registraEvento(LogEventos *log, int tipo, int64_t tempo, int pid, int64_t pagina,
+                           int frame, int op, int motivo, int modificada) {
+    if (log->usados == EVENTOS_BUFFER)
+        despejaEventos(log);
+    RegistroEvento *r = &log->buffer[log->usados++];
+    memset(r, 0, sizeof(*r));
+    r->tempo = (uint64_t)tempo;
+    r->pagina = (uint64_t)pagina;
+    r->pid = (uint32_t)pid;
+    r->frame = frame;
+    r->tipo = (uint8_t)tipo;
+    r->op = (uint8_t)op;
+    r->motivo = (uint8_t)motivo;
+    r->modificada = (uint8_t)modificada;
+}
+
+// Classe do histograma de um intervalo (floor(log2))
+static int classeIntervalo(int64_t intervalo) {
+    int c = 0;
+    while (c < ESTAT_CLASSES - 1 && (intervalo >> (c + 1)) != 0)
+        c++;
+    return c;
+}
+
+// Conta a falta na série temporal, crescendo o vetor até a janela do acesso
+static void contaNaSerie(Estatisticas *e, int64_t acesso) {
+    int64_t ponto = (acesso - 1) / e->janela;
+    if (ponto >= e->capacidade_serie) {
+        int64_t nova_cap = e->capacidade_serie ? e->capacidade_serie * 2 : 64;
+        while (nova_cap <= ponto)
+            nova_cap *= 2;
+        int64_t *nova = realloc(e->serie, (size_t)nova_cap * sizeof(int64_t));
+        if (!nova)
+            return;
+        e->serie = nova;
+        e->capacidade_serie = nova_cap;
+    }
+    while (e->tamanho_serie <= ponto)
+        e->serie[e->tamanho_serie++] = 0;
+    e->serie[ponto]++;
+}
+
+// Hit ou falta na página do processo, já no frame
+void observaAcesso(Simulador *sim, Processo *proc, int64_t pagina, int frame, int falta,
+                   int escrita) {
+    Estatisticas *e = sim->estatisticas;
+    if (e) {
+        if (frame < e->num_frames) {
+            if (falta)
+                e->cargas_frame[frame]++;
+            else
+                e->hits_frame[frame]++;
+        }
+        if (falta) {
+            if (e->ultima_falta > 0)
+                e->intervalo_faltas[classeIntervalo(sim->total_acessos - e->ultima_falta)]++;
+            e->ultima_falta = sim->total_acessos;
+            contaNaSerie(e, sim->total_acessos);
+        }
+    }
+    if (sim->eventos)
+        registraEvento(sim->eventos, falta ? EVENTO_FALTA : EVENTO_HIT, sim->total_acessos,
+                       proc->pid, pagina, frame, escrita ? 'W' : 'R', 0, 0);
+}
+
+// Página carregada sem pedido (leitura antecipada ou promoção a página grande)
+void observaAntecipacao(Simulador *sim, const Processo *proc, int64_t pagina, int frame) {
+    Estatisticas *e = sim->estatisticas;
+    if (e && frame < e->num_frames)
+        e->cargas_frame[frame]++;
+    if (sim->eventos)
+        registraEvento(sim->eventos, EVENTO_ANTECIPACAO, sim->total_acessos, proc->pid, pagina,
+                       frame, 0, 0, 0);
+}
+
+// A página do frame vai sair da memória pelo motivo dado (chamado antes de removê-la)
+void observaExpulsao(Simulador *sim, int frame, int motivo) {
+    const EntradaFrame *ef = &sim->memoria.frames[frame];
+    if (ef->pid == -1)
+        return;
+    int modificada = ef->entrada && (*ef->entrada & PAG_MODIFICADA);
+    Estatisticas *e = sim->estatisticas;
+    if (e) {
+        if (frame < e->num_frames)
+            e->expulsoes_frame[frame]++;
+        e->expulsoes[motivo]++;
+        if (modificada)
+            e->expulsoes_modificadas[motivo]++;
+        Processo *dono = buscaProcesso(sim, ef->pid);
+        if (dono)
+            dono->expulsas++;
+    }
+    if (sim->eventos)
+        registraEvento(sim->eventos, EVENTO_EXPULSAO, sim->total_acessos, ef->pid, ef->pagina,
+                       frame, 0, motivo, modificada);
+}
+
+// Pontos da série até o último acesso (janelas finais sem faltas valem zero)
+static int64_t pontosDaSerie(const Simulador *sim) {
+    const Estatisticas *e = sim->estatisticas;
+    return (sim->total_acessos + e->janela - 1) / e->janela;
+}
+
+// Faltas no ponto da série
+static int64_t faltasNoPonto(const Estatisticas *e, int64_t ponto) {
+    return ponto < e->tamanho_serie ? e->serie[ponto] : 0;
+}
+
+// Acessos cobertos pelo ponto da série (o último pode estar incompleto)
+static int64_t acessosNoPonto(const Simulador *sim, int64_t ponto) {
+    int64_t inicio = ponto * sim->estatisticas->janela;
+    int64_t resto = sim->total_acessos - inicio;
+    return resto < sim->estatisticas->janela ? resto : sim->estatisticas->janela;
+}
+
+// Estatísticas em CSV "longo" (secao,chave,campo,valor), uma medida por linha
+static void escreveCSV(const Simulador *sim, FILE *saida) {
+    const Estatisticas *e = sim->estatisticas;
+    fprintf(saida, "secao,chave,campo,valor\n");
+    fprintf(saida, "resumo,-,acessos,%lld\n", (long long)sim->total_acessos);
+    fprintf(saida, "resumo,-,page_faults,%lld\n", (long long)sim->page_faults);
+    fprintf(saida, "resumo,-,escritas_disco,%lld\n", (long long)sim->escritas_disco);
+    fprintf(saida, "resumo,-,janela_serie,%d\n", e->janela);
+    for (int i = 0; i < sim->num_processos; i++) {
+        const Processo *p = &sim->processos[i];
+        fprintf(saida, "processo,%d,acessos,%lld\n", p->pid, (long long)p->acessos);
+        fprintf(saida, "processo,%d,page_faults,%lld\n", p->pid, (long long)p->faltas);
+        fprintf(saida, "processo,%d,frames,%d\n", p->pid, p->residentes);
+        fprintf(saida, "processo,%d,expulsas,%lld\n", p->pid, (long long)p->expulsas);
+    }
+    for (int f = 0; f < e->num_frames; f++) {
+        fprintf(saida, "frame,%d,cargas,%lld\n", f, (long long)e->cargas_frame[f]);
+        fprintf(saida, "frame,%d,hits,%lld\n", f, (long long)e->hits_frame[f]);
+        fprintf(saida, "frame,%d,expulsoes,%lld\n", f, (long long)e->expulsoes_frame[f]);
+    }
+    for (int c = 0; c < ESTAT_CLASSES; c++) {
+        if (e->intervalo_faltas[c])
+            fprintf(saida, "intervalo_faltas,%llu,faltas,%lld\n", 1ULL << c,
+                    (long long)e->intervalo_faltas[c]);
+    }
+    for (int64_t k = 0, n = pontosDaSerie(sim); k < n; k++) {
+        fprintf(saida, "serie,%lld,acessos,%lld\n", (long long)(k * e->janela),
+                (long long)acessosNoPonto(sim, k));
+        fprintf(saida, "serie,%lld,page_faults,%lld\n", (long long)(k * e->janela),
+                (long long)faltasNoPonto(e, k));
+    }
+    for (int m = 0; m < NUM_MOTIVOS_EXPULSAO; m++) {
+        fprintf(saida, "expulsao,%s,total,%lld\n", nomes_motivos[m], (long long)e->expulsoes[m]);
+        fprintf(saida, "expulsao,%s,modificadas,%lld\n", nomes_motivos[m],
+                (long long)e->expulsoes_modificadas[m]);
+    }
+}
+
+// Estatísticas em um objeto JSON
+static void escreveJSON(const Simulador *sim, FILE *saida) {
+    const Estatisticas *e = sim->estatisticas;
+    fprintf(saida, "{\"acessos\":%lld,\"page_faults\":%lld,\"escritas_disco\":%lld,"
+            "\"janela_serie\":%d,\n\"processos\":[", (long long)sim->total_acessos,
+            (long long)sim->page_faults, (long long)sim->escritas_disco, e->janela);
+    for (int i = 0; i < sim->num_processos; i++) {
+        const Processo *p = &sim->processos[i];
+        fprintf(saida, "%s{\"pid\":%d,\"acessos\":%lld,\"page_faults\":%lld,\"frames\":%d,"
+                "\"expulsas\":%lld}", i ? "," : "", p->pid, (long long)p->acessos,
+                (long long)p->faltas, p->residentes, (long long)p->expulsas);
+    }
+    fprintf(saida, "],\n\"frames\":[");
+    for (int f = 0; f < e->num_frames; f++)
+        fprintf(saida, "%s{\"frame\":%d,\"cargas\":%lld,\"hits\":%lld,\"expulsoes\":%lld}",
+                f ? "," : "", f, (long long)e->cargas_frame[f], (long long)e->hits_frame[f],
+                (long long)e->expulsoes_frame[f]);
+    fprintf(saida, "],\n\"intervalo_faltas\":[");
+    for (int c = 0, primeiro = 1; c < ESTAT_CLASSES; c++) {
+        if (!e->intervalo_faltas[c])
+            continue;
+        fprintf(saida, "%s{\"de\":%llu,\"ate\":%llu,\"faltas\":%lld}", primeiro ? "" : ",",
+                1ULL << c, c == 63 ? ~0ULL : (2ULL << c) - 1, (long long)e->intervalo_faltas[c]);
+        primeiro = 0;
+    }
+    fprintf(saida, "],\n\"serie\":[");
+    for (int64_t k = 0, n = pontosDaSerie(sim); k < n; k++)
+        fprintf(saida, "%s{\"inicio\":%lld,\"acessos\":%lld,\"page_faults\":%lld}", k ? "," : "",
+                (long long)(k * e->janela), (long long)acessosNoPonto(sim, k),
+                (long long)faltasNoPonto(e, k));
+    fprintf(saida, "],\n\"expulsoes\":{");
+    for (int m = 0; m < NUM_MOTIVOS_EXPULSAO; m++)
+        fprintf(saida, "%s\"%s\":{\"total\":%lld,\"modificadas\":%lld}", m ? "," : "",
+                nomes_motivos[m], (long long)e->expulsoes[m], (long long)e->expulsoes_modificadas[m]);
+    fprintf(saida, "}}\n");
+}
+
+// Grava as estatísticas detalhadas em CSV ou JSON. Retorna -1 se estão desligadas
+// ou a gravação falhou
+int escreveEstatisticas(const Simulador *sim, FILE *saida, int json) {
+    if (!sim->estatisticas)
+        return -1;
+    if (json)
+        escreveJSON(sim, saida);
+    else
+        escreveCSV(sim, saida);
+    return ferror(saida) ? -1 : 0;
+}
@@ -0,0 +1,34 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include "estruturas.h"
+
+// Cabeçalho do log binário de eventos (seguido de registros RegistroEvento)
+#define EVENTOS_MAGICO "PGEV"
+#define EVENTOS_VERSAO 1
+
+typedef struct
+{
+    char magico[4];     // "PGEV"
+    uint32_t versao;    // EVENTOS_VERSAO
+    uint64_t reservado; // Zero
+} CabecalhoEventos;
+
+// Os ganchos só são chamados com estatísticas ou log ligados: desligados custam um teste
+#define observando(sim) ((sim)->estatisticas || (sim)->eventos)
+
+// Estatísticas detalhadas (por processo, por frame, intervalo entre faltas, série
+// temporal e motivos de expulsão) e log binário de eventos por acesso
+const char *nomeMotivoExpulsao(int motivo);
+int ativaEstatisticas(Simulador *sim, int janela);
+void reiniciaEstatisticas(Simulador *sim);
+void desativaEstatisticas(Simulador *sim);
+int abreLogEventos(Simulador *sim, const char *caminho);
+int fechaLogEventos(Simulador *sim);
+void observaAcesso(Simulador *sim, Processo *proc, int64_t pagina, int frame, int falta,
+                   int escrita);
+void observaAntecipacao(Simulador *sim, const Processo *proc, int64_t pagina, int frame);
+void observaExpulsao(Simulador *sim, int frame, int motivo);
+int escreveEstatisticas(const Simulador *sim, FILE *saida, int json);
+
+#endif
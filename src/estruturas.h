@@ -1,45 +1,475 @@
 #ifndef ESTRUTURAS_H
 #define ESTRUTURAS_H
 
-typedef struct
-{
-    int presente;      // 1 se a página está na memória , 0 caso contrário
-    int frame;         // Número do frame onde a página está alocada (-1 se não alocada)
-    int modificada;    // 1 se a página foi modificada , 0 caso contrário
-    int referenciada;  // 1 se a página foi referenciada recentemente , 0 caso contrário
-    int tempo_carga;   // Instante em que a página foi carregada na memória
-    int ultimo_acesso; // Instante do último acesso à página
-} Pagina;
+#include <stdint.h>
+#include <stdio.h>
+#include "tabela_hash.h"
+
+// Algoritmos de substituição (valores de Simulador.algoritmo)
+#define ALG_FIFO            0
+#define ALG_LRU             1
+#define ALG_CLOCK           2 // Relógio com bit de referência
+#define ALG_SEGUNDA_CHANCE  3 // FIFO que poupa páginas referenciadas
+#define ALG_CLOCK_MELHORADO 4 // Relógio com classes (R,M) do NRU
+#define ALG_ARC             5 // Adaptive Replacement Cache
+#define ALG_2Q              6 // Filas A1in/A1out/Am
+#define ALG_LIRS            7 // Low Inter-reference Recency Set
+#define ALG_OTIMO           8 // OPT de Belady (só na reprodução de traces)
+#define NUM_ALGORITMOS      9
+
+// Níveis de verbosidade da simulação
+#define VERBOSIDADE_SILENCIOSO 0 // Nenhuma saída
+#define VERBOSIDADE_RESUMO     1 // Apenas o resumo final
+#define VERBOSIDADE_FALTAS     2 // Uma linha por page fault
+#define VERBOSIDADE_COMPLETO   3 // Rastro completo de cada acesso
+
+// Entrada da tabela de páginas compactada em 32 bits. Uma entrada zerada é uma
+// página ausente, então tabelas criadas com calloc já estão prontas
+typedef uint32_t Pagina;
+
+#define PAG_PRESENTE      0x80000000u // Página está na memória
+#define PAG_MODIFICADA    0x40000000u // Página foi escrita desde que foi carregada
+#define PAG_REFERENCIADA  0x20000000u // Página foi acessada recentemente
+#define PAG_MASCARA_FRAME 0x1fffffffu // Frame da página (válido só se presente)
+#define PAG_MAX_FRAMES    0x20000000  // Frames endereçáveis pela PTE
+
+// Frame onde a página está carregada
+#define paginaFrame(p) ((int)((p) & PAG_MASCARA_FRAME))
+
+// Organização das tabelas de páginas (valores de Simulador.modo_tabela)
+#define TABELA_LINEAR     0 // Vetor com uma entrada por página do processo
+#define TABELA_MULTINIVEL 1 // Árvore de níveis alocada no primeiro acesso
+#define TABELA_INVERTIDA  2 // Tabela global (pid, página) -> frame, com hash
+#define NUM_MODOS_TABELA  3
+
+#define NIVEIS_MIN    2
+#define NIVEIS_MAX    4
+#define NIVEIS_PADRAO 3
+
+// Bits do endereço virtual (endereços de 0 a 2^48 - 1)
+#define BITS_ENDERECO_VIRTUAL 48
 
 typedef struct
 {
     int pid;                // Identificador do processo
-    int tamanho;            // Tamanho do processo em bytes
-    int num_paginas;        // Número de páginas do processo
-    Pagina *tabela_paginas; // Tabela de páginas do processo
+    int64_t tamanho;        // Tamanho do processo em bytes
+    int64_t num_paginas;    // Número de páginas do processo
+    Pagina *tabela_paginas; // Tabela linear (NULL nos outros modos)
+    void *raiz;             // Raiz da tabela multinível (NULL até o primeiro acesso)
+    int64_t bytes_tabela;   // Bytes alocados pela tabela multinível
+    // Fluxo de acessos visto pela leitura antecipada
+    int64_t ultima_pagina;  // Página do último gatilho (falta ou uso de página antecipada)
+    int64_t passo;          // Diferença entre os dois últimos gatilhos
+    int janela;             // Páginas antecipadas por gatilho (política adaptativa)
+    // Alocação de frames e estatísticas do processo
+    int64_t acessos;        // Acessos do processo (o seu tempo virtual)
+    int64_t faltas;         // Page faults do processo
+    int64_t ultima_falta;   // Tempo virtual da última falta (PFF)
+    int residentes;         // Frames ocupados pelo processo
+    int cota;               // Frames a que tem direito (tamanho do working set no modo WS)
+    int64_t expulsas;       // Páginas do processo que saíram da memória (com estatísticas)
 } Processo;
 
 typedef struct
 {
-    int num_frames; // Número total de frames na memória física
-    int *frames;    // Array de frames (cada elemento contém o pid e a página)
-                    // Ex: frames[i] = (pid << 16) | num_pagina
-    int *tempo_carga; // Tempo em que cada frame foi carregado (para FIFO)
+    int pid;    // Processo dono do frame (-1 se o frame está livre)
+    int64_t pagina; // Página virtual do processo carregada no frame (-1 se livre)
+    Pagina *entrada; // Entrada da tabela de páginas dessa página (NULL se livre)
+    int ant;    // Frame anterior na lista de recência do LRU (-1 se nenhum)
+    int prox;   // Próximo frame na lista de recência do LRU (-1 se nenhum)
+} EntradaFrame;
+
+// Nó das listas do ARC, 2Q e LIRS: página residente ou fantasma (só o histórico)
+typedef struct
+{
+    uint64_t chave; // chavePagina(pid, página)
+    int frame;      // Frame ocupado pela página (-1 se fantasma)
+    int lir;        // LIRS: 1 se o bloco é LIR
+    // Dois conjuntos de ligações: o LIRS mantém o nó na pilha S e na fila Q ao mesmo tempo
+    int lista[2]; // Lista em que o nó está em cada conjunto (-1 se nenhuma)
+    int ant[2];
+    int prox[2];
+} NoAdaptativo;
+
+typedef struct
+{
+    int cabeca;  // Mais recente
+    int cauda;   // Mais antigo
+    int tamanho;
+} ListaAdaptativa;
+
+#define NUM_LISTAS_ADAPTATIVAS 6
+
+// Estado dos algoritmos resistentes a varreduras (alocado no primeiro uso)
+typedef struct
+{
+    NoAdaptativo *nos;  // Pool de nós (residentes + fantasmas)
+    int capacidade;     // Tamanho do pool
+    int livre;          // Primeiro nó livre (encadeado por prox[0])
+    int *no_do_frame;   // Nó residente em cada frame (-1 se nenhum)
+    MapaHash indice;    // chave -> nó
+    ListaAdaptativa listas[NUM_LISTAS_ADAPTATIVAS];
+    int algoritmo;      // Algoritmo dono das listas
+    int p;              // ARC: tamanho alvo de T1 (adaptado pelos fantasmas)
+    int k_in, k_out;    // 2Q: limites de A1in e A1out
+    int max_lir;        // LIRS: número máximo de blocos LIR
+    int num_lir;        // LIRS: blocos LIR atuais
+    int max_fantasmas;  // LIRS: fantasmas mantidos na pilha S
+} EstadoAdaptativo;
+
+// Bloco de fator frames alinhados, reservável para uma região (fator páginas alinhadas)
+// de um processo: cada página da região só pode ocupar o seu frame no bloco
+typedef struct
+{
+    int pid;         // Dono da reserva (-1 se o bloco não está reservado)
+    int64_t regiao;  // Região reservada (página / fator)
+    int livres;      // Frames livres do bloco
+    int carregadas;  // Páginas da região nos seus frames do bloco
+    int promovida;   // 1 se a região está mapeada por uma página grande
+    int pos_inteiro; // Posição em EstadoGrandes.inteiros (-1 se não está lá)
+} BlocoGrande;
+
+// Estado das páginas grandes (alocado no primeiro uso)
+typedef struct
+{
+    int fator;             // Páginas base por página grande com que os vetores foram montados
+    int num_blocos;        // num_frames / fator (os frames do resto ficam fora dos blocos)
+    BlocoGrande *blocos;
+    int *inteiros;         // Pilha dos blocos sem reserva com todos os frames livres
+    int blocos_livres;     // Blocos em inteiros
+    int *soltos;           // Pilha dos frames livres fora das reservas
+    int num_soltos;
+    int *pos_solto;        // Posição de cada frame em soltos (-1 se não está lá)
+    int *pos_livre;        // Posição de cada frame na pilha de livres (-1 se ocupado)
+    unsigned char *preenchida; // 1 se a página do frame completou uma promoção e não foi usada
+    MapaHash reservas;     // chavePagina(pid, região) -> bloco
+} EstadoGrandes;
+
+// Página guardada no pool da memória comprimida
+typedef struct
+{
+    int pid;        // Dono (-1 se a posição está livre)
+    int64_t pagina; // Página virtual
+    int bytes;      // Tamanho comprimido
+    int modificada; // 1 se o disco não tem a versão atual (grava ao sair do pool)
+    int ant, prox;  // Lista do pool: cabeça = mais recente, cauda = a primeira a sair
+} EntradaComprimida;
+
+// Pool da memória comprimida (alocado na primeira página guardada)
+typedef struct
+{
+    EntradaComprimida *entradas; // capacidade posições, cresce conforme o pool enche
+    int capacidade;
+    int *livres;                 // Pilha das posições livres
+    int num_livres;
+    int cabeca, cauda;
+    int num_paginas;             // Páginas no pool
+    int64_t bytes;               // Soma dos tamanhos comprimidos
+    MapaHash indice;             // chavePagina(pid, página) -> posição
+} EstadoComprimida;
+
+// Estado do OPT: frames em um heap de máximo pelo próximo uso da página
+typedef struct
+{
+    const uint32_t *proximo_uso; // Próximo uso de cada acesso do trace (NULL fora da reprodução)
+    int64_t acesso_atual;        // Índice do acesso sendo traduzido
+    uint32_t *chave;             // Próximo uso da página de cada frame
+    int *heap;                   // Frames ordenados por chave (raiz = vítima)
+    int *posicao;                // Posição de cada frame no heap (-1 se fora)
+    int tamanho;                 // Frames no heap
+} EstadoOtimo;
+
+typedef struct
+{
+    int num_frames;       // Número total de frames na memória física
+    EntradaFrame *frames; // Tabela de páginas invertida: (pid, página) de cada frame
+    // Lista de recência (LRU): cabeça = mais recente, cauda = vítima
+    int lru_cabeca;
+    int lru_cauda;
+    // Fila circular dos frames ocupados em ordem de carga (FIFO)
+    int *fila_fifo;
+    int fifo_inicio;  // Posição do frame carregado há mais tempo
+    int fifo_tamanho; // Quantidade de frames na fila
+    // Pilha de frames livres (topo = frame de menor índice)
+    int *livres;
+    int num_livres;
+    // Ponteiro do relógio (CLOCK e relógio melhorado)
+    int ponteiro_relogio;
+    // Instantes da página de cada frame (fora da PTE, só valem para páginas residentes)
+    int64_t *tempo_carga;
+    int64_t *ultimo_acesso;
+    // Leitura antecipada: instante (ns) em que a página do frame fica pronta; < 0 se
+    // ela não foi antecipada ou já foi usada
+    double *pronta_ns;
+    // Tempo virtual do dono no último acesso à página do frame (working set e PFF)
+    int64_t *uso_virtual;
+    // Listas e parâmetros do ARC, 2Q e LIRS
+    EstadoAdaptativo adaptativo;
+    // Heap do OPT
+    EstadoOtimo otimo;
+    // Reservas e promoções das páginas grandes
+    EstadoGrandes grandes;
+    // Pool da memória comprimida
+    EstadoComprimida comprimida;
+    // Tabela invertida: PTE de cada frame e hash (pid, página) -> frame
+    Pagina *entradas_invertidas; // NULL até o primeiro uso
+    MapaHash hash_invertida;
 } MemoriaFisica;
 
+// Políticas de substituição da TLB (valores de ParametrosTLB.politica)
+#define TLB_LRU       0
+#define TLB_FIFO      1
+#define TLB_ALEATORIA 2
+#define NUM_POLITICAS_TLB 3
+
+// Geometria e política da TLB
+typedef struct
+{
+    int conjuntos[2]; // Conjuntos do L1 e do L2 (0 = nível desligado)
+    int vias[2];      // Associatividade de cada nível
+    int politica;     // TLB_*
+    int asid;         // 1: entradas marcadas com o pid; 0: esvazia a TLB na troca de processo
+} ParametrosTLB;
+
+// Entrada da TLB: (pid, página) -> frame
+typedef struct
+{
+    uint64_t chave; // chavePagina(pid, página): o conjunto sai dos bits baixos
+    int frame;      // Frame da página (-1 se a entrada é inválida)
+    int grande;     // 1: página grande (a chave é da região e o frame, o primeiro do bloco)
+    uint64_t idade; // LRU: instante do último uso; FIFO: instante da inserção
+} EntradaTLB;
+
 typedef struct
 {
-    int tempo_atual;            // Contador de tempo da simulação
+    EntradaTLB *entradas; // conjuntos * vias, cada conjunto contíguo
+    int64_t hits;
+    int64_t misses;
+} NivelTLB;
+
+typedef struct
+{
+    ParametrosTLB parametros;
+    NivelTLB nivel[2];  // L1 e L2
+    uint64_t relogio;   // Instante para as idades das entradas
+    uint32_t semente;   // Estado do gerador da política aleatória
+    int pid_atual;      // Sem ASID: processo dono das entradas (-1 se nenhum)
+    int64_t esvaziamentos; // Sem ASID: trocas de processo que esvaziaram a TLB
+} TLB;
+
+// Políticas de leitura antecipada (valores de ParametrosAntecipacao.politica)
+#define ANTECIPA_NENHUMA    0
+#define ANTECIPA_SEQUENCIAL 1 // As N páginas seguintes
+#define ANTECIPA_PASSO      2 // N páginas no passo detectado em cada processo
+#define ANTECIPA_ADAPTATIVA 3 // Janela que dobra em fluxo sequencial e cai com desperdício
+#define NUM_POLITICAS_ANTECIPACAO 4
+
+#define ANTECIPA_PAGINAS_PADRAO 8
+#define ANTECIPA_PAGINAS_MAX    64
+
+typedef struct
+{
+    int politica; // ANTECIPA_*
+    int paginas;  // Páginas por gatilho (máximo da janela na adaptativa)
+} ParametrosAntecipacao;
+
+// Alocação de frames entre processos (valores de ParametrosAlocacao.modo)
+#define ALOCA_GLOBAL       0 // Todos os processos disputam todos os frames
+#define ALOCA_FIXA         1 // Cota igual para cada processo
+#define ALOCA_PROPORCIONAL 2 // Cota proporcional ao número de páginas do processo
+#define ALOCA_WORKING_SET  3 // Só saem páginas fora do working set do dono (janela Δ)
+#define ALOCA_PFF          4 // Cota ajustada pela frequência de page faults
+#define NUM_MODOS_ALOCACAO 5
+
+#define ALOCA_JANELA_PADRAO  1000
+#define ALOCA_LIMIAR_PADRAO  0.5
+
+typedef struct
+{
+    int modo;    // ALOCA_*
+    int janela;  // Em acessos: Δ do working set, intervalo T do PFF e intervalo da
+                 // detecção de thrashing
+    double limiar_thrashing; // Taxa de faltas de um intervalo que caracteriza thrashing
+} ParametrosAlocacao;
+
+// Páginas grandes: regiões alinhadas de fator páginas promovidas a uma só tradução
+typedef struct
+{
+    int fator;     // Páginas base por página grande, potência de 2 (0 = desligadas)
+    double limiar; // Fração da região carregada no bloco reservado que dispara a promoção
+} ParametrosPaginasGrandes;
+
+#define GRANDES_FATOR_PADRAO  512 // 2 MB com páginas de 4 KB
+#define GRANDES_LIMIAR_PADRAO 0.75
+
+// Memória comprimida (zswap): as páginas que saem da memória são comprimidas num pool
+// de capacidade fixa, e a falta que encontra a página ali não lê o disco. A razão de
+// compressão de cada página é sorteada (pela chave da página) da distribuição dada
+#define COMPRIMIDA_RAZOES_MAX 16
+
+typedef struct
+{
+    int64_t capacidade; // Bytes do pool (0 = desligada)
+    int num_razoes;
+    double razoes[COMPRIMIDA_RAZOES_MAX];     // Tamanho original / comprimido (<= 1: rejeitada)
+    double acumuladas[COMPRIMIDA_RAZOES_MAX]; // Probabilidade acumulada até cada razão
+} ParametrosComprimida;
+
+#define COMPRIMIDA_RAZAO_PADRAO 3.0
+
+// Por que uma página saiu da memória (valores de RegistroEvento.motivo)
+#define EXPULSAO_SUBSTITUICAO 0 // Vítima de uma falta
+#define EXPULSAO_ANTECIPACAO  1 // Vítima para abrir espaço à leitura antecipada
+#define EXPULSAO_WORKING_SET  2 // Saiu do working set do processo
+#define EXPULSAO_PFF          3 // Sem uso desde a falta anterior (PFF)
+#define EXPULSAO_PROCESSO     4 // O processo foi removido
+#define NUM_MOTIVOS_EXPULSAO  5
+
+// Classes do histograma do intervalo entre faltas: a classe c conta intervalos
+// de 2^c a 2^(c+1)-1 acessos
+#define ESTAT_CLASSES 64
+
+#define ESTAT_JANELA_PADRAO 1000 // Acessos por ponto da série de taxa de faltas
+
+// Estatísticas detalhadas, alocadas só quando pedidas
+typedef struct
+{
+    int janela;                // Acessos por ponto da série temporal
+    int num_frames;            // Tamanho dos vetores por frame
+    int64_t *cargas_frame;     // Páginas carregadas em cada frame
+    int64_t *hits_frame;       // Hits em cada frame
+    int64_t *expulsoes_frame;  // Páginas que saíram de cada frame
+    int64_t intervalo_faltas[ESTAT_CLASSES];
+    int64_t ultima_falta;      // Acesso da falta anterior (0 antes da primeira)
+    int64_t *serie;            // Faltas em cada janela de acessos
+    int64_t tamanho_serie;
+    int64_t capacidade_serie;
+    int64_t expulsoes[NUM_MOTIVOS_EXPULSAO];
+    int64_t expulsoes_modificadas[NUM_MOTIVOS_EXPULSAO]; // Das que saíram, as gravadas no disco
+} Estatisticas;
+
+// Tipos de evento do log binário
+#define EVENTO_HIT         0
+#define EVENTO_FALTA       1
+#define EVENTO_EXPULSAO    2
+#define EVENTO_ANTECIPACAO 3 // Página carregada pela leitura antecipada
+
+// Registro do log de eventos (32 bytes, ordem de bytes da máquina)
+typedef struct
+{
+    uint64_t tempo;     // Acesso em que o evento ocorreu
+    uint64_t pagina;    // Página virtual
+    uint32_t pid;
+    int32_t frame;
+    uint8_t tipo;       // EVENTO_*
+    uint8_t op;         // 'R' ou 'W' em hits e faltas; 0 nos demais
+    uint8_t motivo;     // EXPULSAO_* nas expulsões
+    uint8_t modificada; // 1 se a página expulsa foi gravada no disco
+    uint8_t reservado[4];
+} RegistroEvento;
+
+#define EVENTOS_BUFFER 4096 // Registros acumulados antes de cada gravação
+
+// Log de eventos por acesso, gravado em blocos
+typedef struct
+{
+    FILE *arquivo;
+    RegistroEvento *buffer;
+    int usados;               // Registros no buffer ainda não gravados
+    int64_t gravados;         // Registros já enviados ao arquivo
+    int erro;                 // 1 se alguma gravação falhou
+} LogEventos;
+
+// Latências da estimativa do tempo efetivo de acesso, em nanossegundos
+typedef struct
+{
+    double memoria; // Acesso à memória física (todo acesso paga)
+    double falta;   // Leitura da página do disco em um page fault
+    double escrita; // Gravação no disco da página modificada que sai da memória
+    double compressao;    // Compressão da página que entra na memória comprimida
+    double descompressao; // Descompressão da página lida da memória comprimida
+} LatenciasES;
+
+// Valores padrão: DRAM, um disco com 8 ms por operação e um compressor como o zstd
+#define LATENCIA_MEMORIA_PADRAO 100.0
+#define LATENCIA_FALTA_PADRAO   8000000.0
+#define LATENCIA_ESCRITA_PADRAO 8000000.0
+#define LATENCIA_COMPRESSAO_PADRAO    5000.0
+#define LATENCIA_DESCOMPRESSAO_PADRAO 2000.0
+
+typedef struct
+{
+    int64_t tempo_atual;        // Contador de tempo da simulação
     int tamanho_pagina;         // Tamanho da página em bytes
-    int tamanho_memoria_fisica; // Tamanho da memória física em bytes
+    int bits_desloc;            // log2 da página se for potência de 2 (-1 se não for)
+    int64_t mascara_desloc;     // Máscara do deslocamento (página potência de 2)
+    int bits_pagina;            // Bits do maior número de página do espaço virtual
+    int64_t tamanho_memoria_fisica; // Tamanho da memória física em bytes
     int num_processos;          // Número de processos na simulação
     Processo *processos;        // Array de processos
+    MapaHash indice_processos;  // Índice pid -> posição em processos
     MemoriaFisica memoria;      // Memória física
     // Estatísticas
-    int total_acessos; // Total de acessos à memória
-    int page_faults;   // Total de page faults ocorridos
+    int64_t total_acessos; // Total de acessos à memória
+    int64_t page_faults;   // Total de page faults ocorridos
+    int64_t escritas_disco; // Páginas modificadas gravadas ao sair da memória (write-back)
+    LatenciasES latencias;
+    // Vítimas examinadas, na ordem do algoritmo, à procura de uma página limpa (0 = desligado)
+    int janela_limpas;
+    // Leitura antecipada e seus resultados
+    ParametrosAntecipacao antecipacao;
+    int64_t antecipadas;               // Páginas carregadas antes de serem pedidas
+    int64_t antecipadas_uteis;         // Acessadas antes de sair da memória
+    int64_t antecipadas_atrasadas;     // Úteis acessadas antes de a leitura terminar
+    int64_t antecipadas_desperdicadas; // Saíram da memória sem acesso
+    double espera_antecipacao_ns;      // Espera pelas leituras atrasadas
+    // Alocação de frames entre processos e detecção de thrashing
+    ParametrosAlocacao alocacao;
+    int64_t faltas_intervalo;     // Faltas com substituição no intervalo atual
+    int64_t intervalos;           // Intervalos de janela acessos já encerrados
+    int64_t intervalos_thrashing; // Intervalos com essas faltas acima do limiar
+    int64_t faltas_sem_folga;     // Faltas sem vítima fora das cotas ou working sets
+    // Páginas grandes e seus resultados
+    ParametrosPaginasGrandes grandes;
+    int64_t promocoes;          // Regiões promovidas a página grande
+    int64_t rebaixamentos;      // Páginas grandes desfeitas pela saída de uma das páginas
+    int64_t reservas_desfeitas; // Reservas de bloco abandonadas (rebaixamentos incluídos)
+    int64_t faltas_sem_bloco;   // Faltas sem bloco inteiro livre, com frames livres para um
+    int64_t preenchidas;        // Páginas carregadas para completar uma região na promoção
+    int64_t preenchidas_usadas; // Dessas, as acessadas depois
+    int64_t hits_tlb_grandes;   // Hits da TLB em entradas de página grande
+    // Memória comprimida e seus resultados
+    ParametrosComprimida comprimida;
+    int64_t comprimidas;         // Páginas que saíram da memória para o pool
+    int64_t rejeitadas;          // Não comprimiram o bastante ou não cabem no pool
+    int64_t descomprimidas;      // Páginas carregadas do pool (faltas e leitura antecipada)
+    int64_t faltas_comprimidas;  // Faltas atendidas pelo pool, sem ler o disco
+    int64_t devolvidas;          // Páginas que deixaram o pool para abrir espaço
+    int64_t devolvidas_gravadas; // Dessas, as modificadas (gravadas no disco)
+    int64_t pico_comprimida;     // Maior ocupação do pool em bytes
+    // Estatísticas detalhadas e log de eventos (NULL quando desligados)
+    Estatisticas *estatisticas;
+    LogEventos *eventos;
     // Algoritmo de substituição atual
-    int algoritmo; // 0=FIFO , 1=LRU
+    int algoritmo; // ALG_*
+    // Nível de saída (VERBOSIDADE_*)
+    int verbosidade;
+    // Organização das tabelas de páginas
+    int modo_tabela;  // TABELA_*
+    int niveis;       // Níveis da tabela multinível
+    int bits_nivel;   // Bits do número da página consumidos por nível
+    // TLB na frente da tabela de páginas
+    TLB tlb;
 } Simulador;
 
+// Página e deslocamento do endereço: shift e máscara se a página é potência de 2
+#define paginaDoEndereco(sim, e) \
+    ((sim)->bits_desloc >= 0 ? (int64_t)(e) >> (sim)->bits_desloc : (int64_t)(e) / (sim)->tamanho_pagina)
+#define deslocDoEndereco(sim, e) \
+    ((sim)->bits_desloc >= 0 ? (int64_t)(e) & (sim)->mascara_desloc : (int64_t)(e) % (sim)->tamanho_pagina)
+
+// Chave única de (pid, página) nos hashes e na TLB: a página ocupa os bits baixos
+#define chavePagina(sim, pid, pagina) \
+    (((uint64_t)(uint32_t)(pid) << (sim)->bits_pagina) | (uint64_t)(pagina))
+
 #endif
\ No newline at end of file
@@ -0,0 +1,537 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "instantaneo.h"
+#include "algoritmos.h"
+#include "tabela_paginas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define ALINHAMENTO 8 // Toda seção começa em múltiplo de 8 bytes
+
+// FNV-1a de 64 bits: a soma do conteúdo recusa o arquivo corrompido antes que algum
+// índice ou ligação gravada seja usado
+#define SOMA_INICIAL 0xcbf29ce484222325ULL
+#define SOMA_PRIMO   0x100000001b3ULL
+
+static uint64_t acumulaSoma(uint64_t soma, const void *dados, size_t bytes) {
+    const unsigned char *b = dados;
+    for (size_t i = 0; i < bytes; i++)
+        soma = (soma ^ b[i]) * SOMA_PRIMO;
+    return soma;
+}
+
+// Entrada não nula de uma tabela linear (as tabelas lineares são gravadas esparsas)
+typedef struct
+{
+    int64_t pagina;
+    Pagina valor;
+    uint32_t reservado; // Zero
+} EntradaSalva;
+
+// Arquivo em gravação
+typedef struct
+{
+    FILE *arquivo;
+    uint64_t escritos; // Bytes gravados até aqui (com o alinhamento)
+    int erro;          // 1 se alguma escrita falhou
+    size_t bytes_folha; // Bytes de uma folha da tabela multinível
+    uint64_t soma;      // Soma dos bytes gravados (com o alinhamento)
+} Gravacao;
+
+// Grava os bytes e completa com zeros até o próximo alinhamento
+static void grava(Gravacao *g, const void *dados, size_t bytes) {
+    static const unsigned char zeros[ALINHAMENTO] = {0};
+    size_t resto = (ALINHAMENTO - bytes % ALINHAMENTO) % ALINHAMENTO;
+    if (bytes > 0 && fwrite(dados, 1, bytes, g->arquivo) != bytes)
+        g->erro = 1;
+    if (resto > 0 && fwrite(zeros, 1, resto, g->arquivo) != resto)
+        g->erro = 1;
+    g->soma = acumulaSoma(acumulaSoma(g->soma, dados, bytes), zeros, resto);
+    g->escritos += bytes + resto;
+}
+
+// Grava o mapa posição a posição: restaurado, ele sonda as chaves na mesma ordem
+static void gravaMapa(Gravacao *g, const MapaHash *mapa) {
+    int64_t tamanhos[2] = {mapa->capacidade, mapa->tamanho};
+    grava(g, tamanhos, sizeof(tamanhos));
+    grava(g, mapa->chaves, (size_t)mapa->capacidade * sizeof(uint64_t));
+    grava(g, mapa->valores, (size_t)mapa->capacidade * sizeof(int64_t));
+    grava(g, mapa->ocupado, (size_t)mapa->capacidade);
+}
+
+// Conta as folhas da tabela multinível
+static int contaFolha(void *contexto, int64_t primeira, const Pagina *folha) {
+    (void)primeira;
+    (void)folha;
+    (*(int64_t *)contexto)++;
+    return 0;
+}
+
+// Grava a primeira página coberta pela folha e as entradas dela
+static int gravaFolha(void *contexto, int64_t primeira, const Pagina *folha) {
+    Gravacao *g = contexto;
+    grava(g, &primeira, sizeof(primeira));
+    grava(g, folha, g->bytes_folha);
+    return g->erro ? -1 : 0;
+}
+
+// Grava a tabela de páginas do processo (na invertida as entradas são da memória física)
+static void gravaTabela(Gravacao *g, const Simulador *sim, const Processo *proc) {
+    int64_t n = 0;
+    if (sim->modo_tabela == TABELA_LINEAR) {
+        for (int64_t p = 0; p < proc->num_paginas; p++)
+            n += proc->tabela_paginas[p] != 0;
+        grava(g, &n, sizeof(n));
+        for (int64_t p = 0; p < proc->num_paginas; p++) {
+            if (proc->tabela_paginas[p] != 0) {
+                EntradaSalva e = {p, proc->tabela_paginas[p], 0};
+                grava(g, &e, sizeof(e));
+            }
+        }
+    } else if (sim->modo_tabela == TABELA_MULTINIVEL) {
+        percorreFolhas(sim, proc, contaFolha, &n);
+        grava(g, &n, sizeof(n));
+        g->bytes_folha = ((size_t)1 << sim->bits_nivel) * sizeof(Pagina);
+        percorreFolhas(sim, proc, gravaFolha, g);
+    }
+}
+
+// Grava o estado do simulador em caminho; acessos_trace é a posição do trace que o
+// estado alcançou. Grava em caminho.tmp e renomeia, para que um ponto de controle
+// interrompido não destrua o anterior. Retorna -1 em erro
+int salvaInstantaneo(const Simulador *sim, const char *caminho, int64_t acessos_trace) {
+    if (sim->algoritmo == ALG_OTIMO) {
+        fprintf(stderr, "O estado do OPT depende do trace inteiro e nao pode ser gravado\n");
+        return -1;
+    }
+    size_t n = strlen(caminho);
+    char *temporario = malloc(n + 5);
+    if (!temporario)
+        return -1;
+    memcpy(temporario, caminho, n);
+    memcpy(temporario + n, ".tmp", 5);
+    Gravacao g = {fopen(temporario, "wb"), 0, 0, 0, SOMA_INICIAL};
+    if (!g.arquivo) {
+        perror(temporario);
+        free(temporario);
+        return -1;
+    }
+
+    CabecalhoInstantaneo cab = {{'P', 'G', 'S', 'N'}, INSTANTANEO_VERSAO, sizeof(Simulador),
+                                sizeof(Processo), (uint64_t)acessos_trace, 0, 0};
+    grava(&g, &cab, sizeof(cab));
+    g.soma = SOMA_INICIAL; // A soma cobre só o que vem depois do cabeçalho
+    // Os ponteiros gravados junto com as estruturas só dizem, na restauração, se a
+    // seção correspondente está no arquivo
+    grava(&g, sim, sizeof(Simulador));
+    grava(&g, sim->processos, (size_t)sim->num_processos * sizeof(Processo));
+    gravaMapa(&g, &sim->indice_processos);
+    for (int i = 0; i < sim->num_processos; i++)
+        gravaTabela(&g, sim, &sim->processos[i]);
+
+    const MemoriaFisica *mem = &sim->memoria;
+    size_t f = (size_t)mem->num_frames;
+    grava(&g, mem->frames, f * sizeof(EntradaFrame));
+    grava(&g, mem->fila_fifo, f * sizeof(int));
+    grava(&g, mem->livres, f * sizeof(int));
+    grava(&g, mem->tempo_carga, f * sizeof(int64_t));
+    grava(&g, mem->ultimo_acesso, f * sizeof(int64_t));
+    grava(&g, mem->pronta_ns, f * sizeof(double));
+    grava(&g, mem->uso_virtual, f * sizeof(int64_t));
+    if (mem->adaptativo.nos) {
+        grava(&g, mem->adaptativo.nos, (size_t)mem->adaptativo.capacidade * sizeof(NoAdaptativo));
+        grava(&g, mem->adaptativo.no_do_frame, f * sizeof(int));
+        gravaMapa(&g, &mem->adaptativo.indice);
+    }
+    if (mem->grandes.blocos) {
+        size_t blocos = (size_t)mem->grandes.num_blocos;
+        grava(&g, mem->grandes.blocos, blocos * sizeof(BlocoGrande));
+        grava(&g, mem->grandes.inteiros, blocos * sizeof(int));
+        grava(&g, mem->grandes.soltos, f * sizeof(int));
+        grava(&g, mem->grandes.pos_solto, f * sizeof(int));
+        grava(&g, mem->grandes.pos_livre, f * sizeof(int));
+        grava(&g, mem->grandes.preenchida, f);
+        gravaMapa(&g, &mem->grandes.reservas);
+    }
+    if (mem->entradas_invertidas) {
+        grava(&g, mem->entradas_invertidas, f * sizeof(Pagina));
+        gravaMapa(&g, &mem->hash_invertida);
+    }
+    if (mem->comprimida.entradas) {
+        const EstadoComprimida *c = &mem->comprimida;
+        grava(&g, c->entradas, (size_t)c->capacidade * sizeof(EntradaComprimida));
+        grava(&g, c->livres, (size_t)c->capacidade * sizeof(int));
+        gravaMapa(&g, &c->indice);
+    }
+    for (int nivel = 0; nivel < 2; nivel++) {
+        const ParametrosTLB *p = &sim->tlb.parametros;
+        if (sim->tlb.nivel[nivel].entradas)
+            grava(&g, sim->tlb.nivel[nivel].entradas,
+                  (size_t)p->conjuntos[nivel] * p->vias[nivel] * sizeof(EntradaTLB));
+    }
+
+    // Com tudo gravado, o tamanho e a soma completam o cabeçalho
+    cab.tamanho = g.escritos;
+    cab.soma = g.soma;
+    if (fseek(g.arquivo, 0, SEEK_SET) != 0 || fwrite(&cab, sizeof(cab), 1, g.arquivo) != 1)
+        g.erro = 1;
+    if (fclose(g.arquivo) != 0)
+        g.erro = 1;
+#ifdef _WIN32
+    if (!g.erro)
+        remove(caminho); // rename não substitui um arquivo existente no Windows
+#endif
+    if (g.erro || rename(temporario, caminho) != 0) {
+        fprintf(stderr, "Erro ao gravar o estado em %s\n", caminho);
+        remove(temporario);
+        free(temporario);
+        return -1;
+    }
+    free(temporario);
+    return 0;
+}
+
+// Arquivo mapeado em restauração
+typedef struct
+{
+    const unsigned char *dados;
+    uint64_t tamanho;
+    uint64_t posicao; // Início da próxima seção
+} Leitura;
+
+// Próxima seção com bytes bytes; NULL se o arquivo acaba antes
+static const void *le(Leitura *l, uint64_t bytes) {
+    uint64_t resto = (ALINHAMENTO - bytes % ALINHAMENTO) % ALINHAMENTO;
+    uint64_t disponivel = l->tamanho - l->posicao;
+    if (bytes > disponivel || resto > disponivel - bytes)
+        return NULL;
+    const void *p = l->dados + l->posicao;
+    l->posicao += bytes + resto;
+    return p;
+}
+
+// Copia a próxima seção para um vetor novo; NULL se o arquivo acaba ou falta memória
+static void *copia(Leitura *l, uint64_t bytes) {
+    const void *p = le(l, bytes);
+    if (!p)
+        return NULL;
+    void *vetor = malloc(bytes > 0 ? (size_t)bytes : 1);
+    if (vetor)
+        memcpy(vetor, p, (size_t)bytes);
+    return vetor;
+}
+
+// Lê uma quantidade de elementos (int64 não negativo)
+static int leQuantidade(Leitura *l, int64_t *n) {
+    const void *p = le(l, sizeof(int64_t));
+    if (!p)
+        return -1;
+    memcpy(n, p, sizeof(int64_t));
+    return *n < 0 ? -1 : 0;
+}
+
+// Restaura um mapa gravado por gravaMapa
+static int leMapa(Leitura *l, MapaHash *mapa) {
+    int64_t tamanhos[2];
+    const void *p = le(l, sizeof(tamanhos));
+    if (!p)
+        return -1;
+    memcpy(tamanhos, p, sizeof(tamanhos));
+    int64_t capacidade = tamanhos[0];
+    if (capacidade < 1 || capacidade > (1 << 30) || (capacidade & (capacidade - 1)) ||
+        tamanhos[1] < 0 || tamanhos[1] >= capacidade)
+        return -1;
+    mapa->capacidade = (int)capacidade;
+    mapa->tamanho = (int)tamanhos[1];
+    mapa->chaves = copia(l, (uint64_t)capacidade * sizeof(uint64_t));
+    mapa->valores = copia(l, (uint64_t)capacidade * sizeof(int64_t));
+    mapa->ocupado = copia(l, (uint64_t)capacidade);
+    return (mapa->chaves && mapa->valores && mapa->ocupado) ? 0 : -1;
+}
+
+// Restaura a tabela de páginas gravada por gravaTabela
+static int leTabela(Leitura *l, Simulador *sim, Processo *proc) {
+    int64_t n;
+    if (sim->modo_tabela == TABELA_LINEAR) {
+        if (criaTabela(sim, proc) != 0 || leQuantidade(l, &n) != 0 || n > proc->num_paginas)
+            return -1;
+        const unsigned char *entradas = le(l, (uint64_t)n * sizeof(EntradaSalva));
+        if (!entradas)
+            return -1;
+        for (int64_t i = 0; i < n; i++) {
+            EntradaSalva e;
+            memcpy(&e, entradas + i * sizeof(EntradaSalva), sizeof(e));
+            if (e.pagina < 0 || e.pagina >= proc->num_paginas)
+                return -1;
+            proc->tabela_paginas[e.pagina] = e.valor;
+        }
+    } else if (sim->modo_tabela == TABELA_MULTINIVEL) {
+        int64_t por_folha = (int64_t)1 << sim->bits_nivel;
+        if (leQuantidade(l, &n) != 0)
+            return -1;
+        for (int64_t i = 0; i < n; i++) {
+            const void *p = le(l, sizeof(int64_t));
+            const void *folha = le(l, (uint64_t)por_folha * sizeof(Pagina));
+            int64_t primeira;
+            Pagina *entrada;
+            if (!p || !folha)
+                return -1;
+            memcpy(&primeira, p, sizeof(primeira));
+            // Recria o caminho até a folha (e com ele os bytes da tabela)
+            if (primeira < 0 || primeira % por_folha != 0 ||
+                buscaEntrada(sim, proc, primeira, &entrada) != 0)
+                return -1;
+            memcpy(entrada, folha, (size_t)por_folha * sizeof(Pagina));
+        }
+    }
+    return 0;
+}
+
+// Configuração gravada coerente com os vetores que o arquivo deve trazer
+static int configuracaoValida(const Simulador *s) {
+    return s->tamanho_pagina > 0 && s->tamanho_memoria_fisica >= s->tamanho_pagina &&
+           s->memoria.num_frames == s->tamanho_memoria_fisica / s->tamanho_pagina &&
+           s->memoria.num_frames <= PAG_MAX_FRAMES &&
+           s->bits_pagina == bitsNumeroPagina(s->tamanho_pagina) &&
+           s->modo_tabela >= 0 && s->modo_tabela < NUM_MODOS_TABELA &&
+           s->niveis >= NIVEIS_MIN && s->niveis <= NIVEIS_MAX &&
+           s->bits_nivel == (s->bits_pagina + s->niveis - 1) / s->niveis &&
+           s->algoritmo >= 0 && s->algoritmo < NUM_ALGORITMOS && s->algoritmo != ALG_OTIMO &&
+           s->comprimida.num_razoes >= 1 && s->comprimida.num_razoes <= COMPRIMIDA_RAZOES_MAX &&
+           s->num_processos >= 0;
+}
+
+// Lê as seções na ordem de salvaInstantaneo para novo, que parte sem nada alocado
+static int restauraSecoes(Simulador *novo, const Simulador *salvo, Leitura *l) {
+    int n = salvo->num_processos;
+    if (n > 0) {
+        const void *p = le(l, (uint64_t)n * sizeof(Processo));
+        if (!p || !(novo->processos = malloc((size_t)n * sizeof(Processo))))
+            return -1;
+        memcpy(novo->processos, p, (size_t)n * sizeof(Processo));
+        for (int i = 0; i < n; i++) {
+            novo->processos[i].tabela_paginas = NULL;
+            novo->processos[i].raiz = NULL;
+            novo->processos[i].bytes_tabela = 0;
+        }
+        novo->num_processos = n;
+    }
+    if (leMapa(l, &novo->indice_processos) != 0)
+        return -1;
+    for (int i = 0; i < n; i++) {
+        if (buscaProcesso(novo, novo->processos[i].pid) != &novo->processos[i] ||
+            leTabela(l, novo, &novo->processos[i]) != 0)
+            return -1;
+    }
+
+    MemoriaFisica *mem = &novo->memoria;
+    uint64_t f = (uint64_t)mem->num_frames;
+    if (!(mem->frames = copia(l, f * sizeof(EntradaFrame))) ||
+        !(mem->fila_fifo = copia(l, f * sizeof(int))) ||
+        !(mem->livres = copia(l, f * sizeof(int))) ||
+        !(mem->tempo_carga = copia(l, f * sizeof(int64_t))) ||
+        !(mem->ultimo_acesso = copia(l, f * sizeof(int64_t))) ||
+        !(mem->pronta_ns = copia(l, f * sizeof(double))) ||
+        !(mem->uso_virtual = copia(l, f * sizeof(int64_t))))
+        return -1;
+    if (salvo->memoria.adaptativo.nos) {
+        EstadoAdaptativo *est = &mem->adaptativo;
+        if (est->capacidade != 2 * mem->num_frames + 2 ||
+            !(est->nos = copia(l, (uint64_t)est->capacidade * sizeof(NoAdaptativo))) ||
+            !(est->no_do_frame = copia(l, f * sizeof(int))) || leMapa(l, &est->indice) != 0)
+            return -1;
+    }
+    if (salvo->memoria.grandes.blocos) {
+        EstadoGrandes *g = &mem->grandes;
+        uint64_t blocos = (uint64_t)g->num_blocos;
+        if (g->fator < 1 || g->num_blocos != mem->num_frames / g->fator ||
+            g->blocos_livres < 0 || g->blocos_livres > g->num_blocos ||
+            g->num_soltos < 0 || g->num_soltos > mem->num_frames ||
+            !(g->blocos = copia(l, blocos * sizeof(BlocoGrande))) ||
+            !(g->inteiros = copia(l, blocos * sizeof(int))) ||
+            !(g->soltos = copia(l, f * sizeof(int))) ||
+            !(g->pos_solto = copia(l, f * sizeof(int))) ||
+            !(g->pos_livre = copia(l, f * sizeof(int))) || !(g->preenchida = copia(l, f)) ||
+            leMapa(l, &g->reservas) != 0)
+            return -1;
+    }
+    if (salvo->memoria.entradas_invertidas) {
+        if (!(mem->entradas_invertidas = copia(l, f * sizeof(Pagina))) ||
+            leMapa(l, &mem->hash_invertida) != 0)
+            return -1;
+    }
+    if (salvo->memoria.comprimida.entradas) {
+        EstadoComprimida *c = &mem->comprimida;
+        if (c->capacidade < 1 || c->num_livres < 0 || c->num_livres > c->capacidade ||
+            !(c->entradas = copia(l, (uint64_t)c->capacidade * sizeof(EntradaComprimida))) ||
+            !(c->livres = copia(l, (uint64_t)c->capacidade * sizeof(int))) ||
+            leMapa(l, &c->indice) != 0)
+            return -1;
+    }
+    for (int nivel = 0; nivel < 2; nivel++) {
+        const ParametrosTLB *p = &novo->tlb.parametros;
+        if (!salvo->tlb.nivel[nivel].entradas)
+            continue;
+        if (p->conjuntos[nivel] < 1 || p->vias[nivel] < 1 ||
+            !(novo->tlb.nivel[nivel].entradas =
+                  copia(l, (uint64_t)p->conjuntos[nivel] * p->vias[nivel] * sizeof(EntradaTLB))))
+            return -1;
+    }
+
+    // Religa cada frame ocupado à entrada da sua página nas tabelas recriadas
+    for (int i = 0; i < mem->num_frames; i++) {
+        EntradaFrame *ef = &mem->frames[i];
+        ef->entrada = NULL;
+        if (ef->pid == -1)
+            continue;
+        Processo *proc = buscaProcesso(novo, ef->pid);
+        if (!proc || ef->pagina < 0 || ef->pagina >= proc->num_paginas)
+            return -1;
+        if (novo->modo_tabela == TABELA_INVERTIDA) {
+            if (!mem->entradas_invertidas)
+                return -1;
+            ef->entrada = &mem->entradas_invertidas[i];
+        } else if (buscaEntrada(novo, proc, ef->pagina, &ef->entrada) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Monta o simulador a partir do arquivo já validado e troca sim por ele
+static int restauraDe(Simulador *sim, Leitura *l) {
+    Simulador salvo, novo;
+    const void *p = le(l, sizeof(Simulador));
+    if (!p)
+        return -1;
+    memcpy(&salvo, p, sizeof(salvo));
+    if (!configuracaoValida(&salvo))
+        return -1;
+
+    // Nenhum ponteiro do arquivo vale aqui: novo parte sem nada alocado, para
+    // que uma restauração interrompida possa ser liberada por liberarSimulador
+    novo = salvo;
+    novo.num_processos = 0;
+    novo.processos = NULL;
+    memset(&novo.indice_processos, 0, sizeof(MapaHash));
+    MemoriaFisica *mem = &novo.memoria;
+    mem->frames = NULL;
+    mem->fila_fifo = NULL;
+    mem->livres = NULL;
+    mem->tempo_carga = NULL;
+    mem->ultimo_acesso = NULL;
+    mem->pronta_ns = NULL;
+    mem->uso_virtual = NULL;
+    mem->adaptativo.nos = NULL;
+    mem->adaptativo.no_do_frame = NULL;
+    memset(&mem->adaptativo.indice, 0, sizeof(MapaHash));
+    memset(&mem->otimo, 0, sizeof(EstadoOtimo)); // O OPT não é gravado
+    mem->grandes.blocos = NULL;
+    mem->grandes.inteiros = NULL;
+    mem->grandes.soltos = NULL;
+    mem->grandes.pos_solto = NULL;
+    mem->grandes.pos_livre = NULL;
+    mem->grandes.preenchida = NULL;
+    memset(&mem->grandes.reservas, 0, sizeof(MapaHash));
+    mem->entradas_invertidas = NULL;
+    memset(&mem->hash_invertida, 0, sizeof(MapaHash));
+    mem->comprimida.entradas = NULL;
+    mem->comprimida.livres = NULL;
+    memset(&mem->comprimida.indice, 0, sizeof(MapaHash));
+    novo.tlb.nivel[0].entradas = NULL;
+    novo.tlb.nivel[1].entradas = NULL;
+    novo.estatisticas = NULL; // Estatísticas detalhadas e log recomeçam na restauração
+    novo.eventos = NULL;
+
+    if (restauraSecoes(&novo, &salvo, l) != 0) {
+        liberarSimulador(&novo);
+        return -1;
+    }
+    liberarSimulador(sim);
+    *sim = novo;
+    return 0;
+}
+
+// Substitui o estado de sim pelo gravado em caminho, que é mapeado na memória e
+// copiado para as estruturas do simulador. Em *acessos_trace fica a posição do
+// trace em que o estado foi gravado. Em erro, sim fica como estava e retorna -1
+int restauraInstantaneo(Simulador *sim, const char *caminho, int64_t *acessos_trace) {
+    Leitura l = {NULL, 0, 0};
+#ifndef _WIN32
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        perror(caminho);
+        return -1;
+    }
+    struct stat st;
+    void *mapa = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        mapa = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        fprintf(stderr, "%s: nao foi possivel mapear o arquivo\n", caminho);
+        return -1;
+    }
+    l.dados = mapa;
+    l.tamanho = (uint64_t)st.st_size;
+#else
+    // Sem mmap: o arquivo inteiro é lido para um buffer
+    FILE *arquivo = fopen(caminho, "rb");
+    if (!arquivo) {
+        perror(caminho);
+        return -1;
+    }
+    long tamanho = -1;
+    if (fseek(arquivo, 0, SEEK_END) == 0)
+        tamanho = ftell(arquivo);
+    unsigned char *dados = tamanho > 0 ? malloc((size_t)tamanho) : NULL;
+    if (!dados || fseek(arquivo, 0, SEEK_SET) != 0 ||
+        fread(dados, 1, (size_t)tamanho, arquivo) != (size_t)tamanho) {
+        fprintf(stderr, "Erro ao ler %s\n", caminho);
+        free(dados);
+        fclose(arquivo);
+        return -1;
+    }
+    fclose(arquivo);
+    l.dados = dados;
+    l.tamanho = (uint64_t)tamanho;
+#endif
+
+    int status = -1;
+    CabecalhoInstantaneo cab;
+    const void *p = le(&l, sizeof(cab));
+    if (p)
+        memcpy(&cab, p, sizeof(cab));
+    if (!p || memcmp(cab.magico, INSTANTANEO_MAGICO, 4) != 0)
+        fprintf(stderr, "%s: nao e um estado gravado do simulador\n", caminho);
+    else if (cab.versao != INSTANTANEO_VERSAO || cab.bytes_simulador != sizeof(Simulador) ||
+             cab.bytes_processo != sizeof(Processo))
+        fprintf(stderr, "%s: estado gravado por outra versao do simulador\n", caminho);
+    else if (cab.tamanho != l.tamanho || cab.acessos_trace > (uint64_t)INT64_MAX)
+        fprintf(stderr, "%s: estado truncado\n", caminho);
+    else if (acumulaSoma(SOMA_INICIAL, l.dados + l.posicao, l.tamanho - l.posicao) != cab.soma)
+        fprintf(stderr, "%s: estado corrompido\n", caminho);
+    else if (restauraDe(sim, &l) != 0)
+        fprintf(stderr, "%s: estado invalido ou sem memoria para restaura-lo\n", caminho);
+    else {
+        *acessos_trace = (int64_t)cab.acessos_trace;
+        status = 0;
+    }
+
+#ifndef _WIN32
+    munmap(mapa, (size_t)st.st_size);
+#else
+    free(dados);
+#endif
+    return status;
+}
@@ -0,0 +1,27 @@
+#ifndef INSTANTANEO_H
+#define INSTANTANEO_H
+
+#include "estruturas.h"
+
+// Cabeçalho do instantâneo do estado do simulador (seguido das seções, cada uma
+// alinhada a 8 bytes, na ordem de bytes e no layout de estruturas da máquina)
+#define INSTANTANEO_MAGICO "PGSN"
+#define INSTANTANEO_VERSAO 5
+
+typedef struct
+{
+    char magico[4];           // "PGSN"
+    uint32_t versao;          // INSTANTANEO_VERSAO
+    uint32_t bytes_simulador; // sizeof(Simulador) de quem gravou
+    uint32_t bytes_processo;  // sizeof(Processo) de quem gravou
+    uint64_t acessos_trace;   // Acessos do trace já reproduzidos
+    uint64_t tamanho;         // Tamanho total do arquivo
+    uint64_t soma;            // FNV-1a de 64 bits dos bytes depois do cabeçalho
+} CabecalhoInstantaneo;
+
+// Grava e restaura o estado completo (frames, tabelas de páginas, estruturas dos
+// algoritmos, TLB, páginas grandes, memória comprimida e contadores)
+int salvaInstantaneo(const Simulador *sim, const char *caminho, int64_t acessos_trace);
+int restauraInstantaneo(Simulador *sim, const char *caminho, int64_t *acessos_trace);
+
+#endif
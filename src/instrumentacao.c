@@ -0,0 +1,148 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "instrumentacao.h"
+
+#ifdef INSTRUMENTACAO
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(INSTRUMENTACAO_RELOGIO)
+#include <x86intrin.h>
+#define USA_RDTSC
+#endif
+
+// Faixa k: durações em [2^(k-1), 2^k), a 0 só com duração 0. A última acumula também as
+// maiores (um delta do rdtsc que ficou negativo depois de trocar de núcleo dá volta)
+#define NUM_FAIXAS 64
+
+static const char *const nomes_fases[NUM_FASES] = {
+    "processo", "tabela", "vitima", "despejo", "carga", "hit", "impressao", "traducao"};
+
+// Contadores de uma thread; as tabelas formam uma lista somada na impressão
+typedef struct TabelaFases
+{
+    uint64_t vezes[NUM_FASES];
+    uint64_t total[NUM_FASES];
+    uint64_t minimo[NUM_FASES];
+    uint64_t maximo[NUM_FASES];
+    uint64_t faixas[NUM_FASES][NUM_FAIXAS];
+    struct TabelaFases *prox;
+} TabelaFases;
+
+static _Thread_local TabelaFases *tabela_local;
+static TabelaFases *tabelas;
+static pthread_mutex_t trava_tabelas = PTHREAD_MUTEX_INITIALIZER;
+
+uint64_t instrAgora(void) {
+#ifdef USA_RDTSC
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Cria a tabela da thread no primeiro registro; a primeira de todas agenda a impressão
+static TabelaFases *tabelaDaThread(void) {
+    TabelaFases *t = calloc(1, sizeof(TabelaFases));
+    if (!t)
+        return NULL;
+    for (int f = 0; f < NUM_FASES; f++)
+        t->minimo[f] = UINT64_MAX;
+    pthread_mutex_lock(&trava_tabelas);
+    if (!tabelas)
+        atexit(instrImprime);
+    t->prox = tabelas;
+    tabelas = t;
+    pthread_mutex_unlock(&trava_tabelas);
+    return t;
+}
+
+static int faixaDe(uint64_t duracao) {
+#ifdef __GNUC__
+    int k = duracao ? 64 - __builtin_clzll(duracao) : 0;
+    return k < NUM_FAIXAS ? k : NUM_FAIXAS - 1;
+#else
+    int k = 0;
+    while (duracao && k < NUM_FAIXAS - 1) {
+        duracao >>= 1;
+        k++;
+    }
+    return k;
+#endif
+}
+
+void instrRegistra(int fase, uint64_t duracao) {
+    TabelaFases *t = tabela_local;
+    if (!t && !(t = tabela_local = tabelaDaThread()))
+        return;
+    t->vezes[fase]++;
+    t->total[fase] += duracao;
+    if (duracao < t->minimo[fase])
+        t->minimo[fase] = duracao;
+    if (duracao > t->maximo[fase])
+        t->maximo[fase] = duracao;
+    t->faixas[fase][faixaDe(duracao)]++;
+}
+
+// Soma as tabelas de todas as threads e imprime o resumo e os histogramas de cada
+// fase. Chamada ao fim do programa, quando as threads já terminaram
+void instrImprime(void) {
+    TabelaFases soma = {0};
+    for (int f = 0; f < NUM_FASES; f++)
+        soma.minimo[f] = UINT64_MAX;
+    pthread_mutex_lock(&trava_tabelas);
+    for (const TabelaFases *t = tabelas; t; t = t->prox) {
+        for (int f = 0; f < NUM_FASES; f++) {
+            soma.vezes[f] += t->vezes[f];
+            soma.total[f] += t->total[f];
+            if (t->minimo[f] < soma.minimo[f])
+                soma.minimo[f] = t->minimo[f];
+            if (t->maximo[f] > soma.maximo[f])
+                soma.maximo[f] = t->maximo[f];
+            for (int k = 0; k < NUM_FAIXAS; k++)
+                soma.faixas[f][k] += t->faixas[f][k];
+        }
+    }
+    pthread_mutex_unlock(&trava_tabelas);
+
+#ifdef USA_RDTSC
+    const char *unidade = "ciclos";
+#else
+    const char *unidade = "ns";
+#endif
+    uint64_t total_traducao = soma.total[FASE_TRADUCAO];
+    fprintf(stderr, "\n===== Instrumentacao (%s) =====\n", unidade);
+    fprintf(stderr, "%-10s %12s %16s %10s %8s %12s %7s\n", "fase", "vezes", "total", "media",
+            "min", "max", "%trad");
+    for (int f = 0; f < NUM_FASES; f++) {
+        if (!soma.vezes[f])
+            continue;
+        fprintf(stderr, "%-10s %12llu %16llu %10.1f %8llu %12llu %6.1f%%\n", nomes_fases[f],
+                (unsigned long long)soma.vezes[f], (unsigned long long)soma.total[f],
+                (double)soma.total[f] / soma.vezes[f], (unsigned long long)soma.minimo[f],
+                (unsigned long long)soma.maximo[f],
+                total_traducao ? 100.0 * soma.total[f] / total_traducao : 0.0);
+    }
+    for (int f = 0; f < NUM_FASES; f++) {
+        if (!soma.vezes[f])
+            continue;
+        fprintf(stderr, "\nHistograma de %s:\n", nomes_fases[f]);
+        for (int k = 0; k < NUM_FAIXAS; k++) {
+            if (!soma.faixas[f][k])
+                continue;
+            uint64_t inicio = k ? UINT64_C(1) << (k - 1) : 0;
+            fprintf(stderr, "  >= %-12llu %12llu (%5.1f%%)\n", (unsigned long long)inicio,
+                    (unsigned long long)soma.faixas[f][k],
+                    100.0 * soma.faixas[f][k] / soma.vezes[f]);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#include <stdint.h>
+
+// Instrumentação das fases da tradução, ligada só na compilação com -DINSTRUMENTACAO.
+// Desligada, as macros somem e não sobra nenhuma leitura de relógio no caminho quente.
+// Ligada, cada thread acumula a duração das fases em histogramas de potências de 2,
+// somados e impressos na saída de erro ao fim do programa. A unidade é ciclos (rdtsc)
+// em x86 e ns (clock_gettime) nas demais; -DINSTRUMENTACAO_RELOGIO força ns
+
+// Fases medidas (as de dentro da tradução não se sobrepõem, exceto IMPRESSAO: as
+// mensagens de rebaixamento e da memória comprimida saem durante VITIMA ou DESPEJO e
+// contam nas duas; TRADUCAO é o acesso todo)
+#define FASE_PROCESSO  0 // Busca do processo e preparo do algoritmo
+#define FASE_TABELA    1 // Consulta à TLB e à tabela de páginas
+#define FASE_VITIMA    2 // Escolha do frame: livre ou vítima do algoritmo
+#define FASE_DESPEJO   3 // Gravação ou compressão da vítima e limpeza do frame
+#define FASE_CARGA     4 // Atualização da tabela, do algoritmo e da TLB na falta
+#define FASE_HIT       5 // Bits R/M, TLB e estruturas do algoritmo no hit
+#define FASE_IMPRESSAO 6 // Mensagens das verbosidades 2 e 3
+#define FASE_TRADUCAO  7 // traduzAcesso inteiro
+#define NUM_FASES      8
+
+#ifdef INSTRUMENTACAO
+
+uint64_t instrAgora(void);
+void instrRegistra(int fase, uint64_t duracao);
+void instrImprime(void);
+
+#define INSTR_INICIO(marca)     uint64_t marca = instrAgora()
+#define INSTR_FIM(fase, marca)  instrRegistra((fase), instrAgora() - (marca))
+
+#else
+
+#define INSTR_INICIO(marca)     ((void)0)
+#define INSTR_FIM(fase, marca)  ((void)0)
+
+#endif
+
+#endif
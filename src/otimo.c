@@ -0,0 +1,147 @@
+#include "otimo.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Calcula, em uma passada de trás para frente, a posição do próximo acesso à
+// mesma página de cada acesso (OTIMO_NUNCA se não há); NULL em erro
+uint32_t *calculaProximoUso(const Simulador *sim, const AcessoTrace *acessos, int64_t num_acessos) {
+    // Posições de 32 bits: metade da memória de um vetor de 64 bits
+    if (num_acessos >= (int64_t)OTIMO_NUNCA) {
+        fprintf(stderr, "Trace longo demais para o OPT\n");
+        return NULL;
+    }
+    uint32_t *proximo = malloc((size_t)(num_acessos > 0 ? num_acessos : 1) * sizeof(uint32_t));
+    MapaHash ultimo; // (pid, página) -> acesso mais próximo já visto
+    if (!proximo || mapaInicializa(&ultimo, 1024) != 0) {
+        free(proximo);
+        return NULL;
+    }
+
+    for (int64_t i = num_acessos - 1; i >= 0; i--) {
+        uint64_t chave = chavePagina(sim, acessos[i].pid, paginaDoEndereco(sim, acessos[i].endereco));
+        int64_t seguinte;
+        proximo[i] = mapaBusca(&ultimo, chave, &seguinte) ? (uint32_t)seguinte : OTIMO_NUNCA;
+        if (mapaInsere(&ultimo, chave, i) != 0) {
+            free(proximo);
+            proximo = NULL;
+            break;
+        }
+    }
+    mapaLibera(&ultimo);
+    return proximo;
+}
+
+// Troca duas posições do heap mantendo o índice frame -> posição
+static void troca(EstadoOtimo *ot, int a, int b) {
+    int fa = ot->heap[a], fb = ot->heap[b];
+    ot->heap[a] = fb;
+    ot->heap[b] = fa;
+    ot->posicao[fb] = a;
+    ot->posicao[fa] = b;
+}
+
+// Sobe a posição enquanto a chave for maior que a do pai
+static void sobe(EstadoOtimo *ot, int i) {
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (ot->chave[ot->heap[pai]] >= ot->chave[ot->heap[i]])
+            break;
+        troca(ot, i, pai);
+        i = pai;
+    }
+}
+
+// Desce a posição enquanto algum filho tiver chave maior
+static void desce(EstadoOtimo *ot, int i) {
+    for (;;) {
+        int maior = i, esq = 2 * i + 1, dir = 2 * i + 2;
+        if (esq < ot->tamanho && ot->chave[ot->heap[esq]] > ot->chave[ot->heap[maior]])
+            maior = esq;
+        if (dir < ot->tamanho && ot->chave[ot->heap[dir]] > ot->chave[ot->heap[maior]])
+            maior = dir;
+        if (maior == i)
+            return;
+        troca(ot, i, maior);
+        i = maior;
+    }
+}
+
+// Tira do heap o frame na posição i
+static void removePosicao(EstadoOtimo *ot, int i) {
+    int frame = ot->heap[i];
+    ot->tamanho--;
+    if (i != ot->tamanho) {
+        int movido = ot->heap[ot->tamanho];
+        troca(ot, i, ot->tamanho);
+        sobe(ot, i);
+        desce(ot, ot->posicao[movido]);
+    }
+    ot->posicao[frame] = -1;
+}
+
+// Aloca o heap no primeiro uso do OPT
+int preparaOtimo(MemoriaFisica *mem) {
+    EstadoOtimo *ot = &mem->otimo;
+    if (ot->heap)
+        return 0;
+    ot->chave = malloc(mem->num_frames * sizeof(uint32_t));
+    ot->heap = malloc(mem->num_frames * sizeof(int));
+    ot->posicao = malloc(mem->num_frames * sizeof(int));
+    if (!ot->chave || !ot->heap || !ot->posicao) {
+        liberaOtimo(mem);
+        return -1;
+    }
+    reiniciaOtimo(mem);
+    return 0;
+}
+
+// Esvazia o heap
+void reiniciaOtimo(MemoriaFisica *mem) {
+    EstadoOtimo *ot = &mem->otimo;
+    if (!ot->heap)
+        return;
+    for (int f = 0; f < mem->num_frames; f++)
+        ot->posicao[f] = -1;
+    ot->tamanho = 0;
+}
+
+// Libera o heap (o vetor de próximos usos pertence a quem reproduz o trace)
+void liberaOtimo(MemoriaFisica *mem) {
+    EstadoOtimo *ot = &mem->otimo;
+    free(ot->chave);
+    free(ot->heap);
+    free(ot->posicao);
+    ot->chave = NULL;
+    ot->heap = NULL;
+    ot->posicao = NULL;
+    ot->tamanho = 0;
+}
+
+// Retira a vítima: o frame cuja página será usada mais tarde (ou nunca), O(log frames)
+int vitimaOtimo(MemoriaFisica *mem) {
+    EstadoOtimo *ot = &mem->otimo;
+    int frame = ot->heap[0];
+    removePosicao(ot, 0);
+    return frame;
+}
+
+// Atualiza o próximo uso da página do frame com o acesso atual, O(log frames)
+void atualizaOtimo(MemoriaFisica *mem, int frame) {
+    EstadoOtimo *ot = &mem->otimo;
+    ot->chave[frame] = ot->proximo_uso[ot->acesso_atual];
+    int i = ot->posicao[frame];
+    if (i < 0) {
+        i = ot->tamanho++;
+        ot->heap[i] = frame;
+        ot->posicao[frame] = i;
+    }
+    // Em um hit a chave só cresce (a antiga era o próprio acesso atual), então só sobe
+    sobe(ot, i);
+}
+
+// Tira o frame liberado do heap (processo removido)
+void liberaFrameOtimo(MemoriaFisica *mem, int frame) {
+    EstadoOtimo *ot = &mem->otimo;
+    if (ot->heap && ot->posicao[frame] >= 0)
+        removePosicao(ot, ot->posicao[frame]);
+}
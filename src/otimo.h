@@ -0,0 +1,20 @@
+#ifndef OTIMO_H
+#define OTIMO_H
+
+#include <stdint.h>
+#include "estruturas.h"
+#include "trace.h"
+
+// Próximo uso de uma página que não é mais acessada no trace
+#define OTIMO_NUNCA UINT32_MAX
+
+// OPT (Belady): vítima é a página cujo próximo uso está mais longe
+uint32_t *calculaProximoUso(const Simulador *sim, const AcessoTrace *acessos, int64_t num_acessos);
+int preparaOtimo(MemoriaFisica *mem);
+void reiniciaOtimo(MemoriaFisica *mem);
+void liberaOtimo(MemoriaFisica *mem);
+int vitimaOtimo(MemoriaFisica *mem);
+void atualizaOtimo(MemoriaFisica *mem, int frame);
+void liberaFrameOtimo(MemoriaFisica *mem, int frame);
+
+#endif
@@ -0,0 +1,352 @@
+#include "paginas_grandes.h"
+#include "algoritmos.h"
+#include "tlb.h"
+#include "instrumentacao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Troca fator e limiar; as reservas são refeitas e a memória esvaziada. Retorna -1
+// se os parâmetros forem inválidos (fator 0 desliga as páginas grandes)
+int configuraPaginasGrandes(Simulador *sim, const ParametrosPaginasGrandes *parametros) {
+    const ParametrosPaginasGrandes *p = parametros;
+    if (p->fator != 0 && (p->fator < 2 || (p->fator & (p->fator - 1)) || p->fator > GRANDES_FATOR_MAX))
+        return -1;
+    if (!(p->limiar > 0.0) || p->limiar > 1.0)
+        return -1;
+    liberaGrandes(&sim->memoria);
+    sim->grandes = *p;
+    reinicializarMemoria(sim);
+    return 0;
+}
+
+// Páginas base por página grande de tamanho_grande bytes; -1 se não for um múltiplo
+// potência de 2 (a partir de 2) da página
+int fatorPaginaGrande(int tamanho_grande, int tamanho_pagina) {
+    if (tamanho_pagina <= 0 || tamanho_grande % tamanho_pagina != 0)
+        return -1;
+    int fator = tamanho_grande / tamanho_pagina;
+    if (fator < 2 || (fator & (fator - 1)) || fator > GRANDES_FATOR_MAX)
+        return -1;
+    return fator;
+}
+
+// Empilha o bloco entre os inteiros livres
+static void entraInteiro(EstadoGrandes *g, int b) {
+    g->blocos[b].pos_inteiro = g->blocos_livres;
+    g->inteiros[g->blocos_livres++] = b;
+}
+
+// Tira o bloco dos inteiros livres, pondo o do topo no lugar dele
+static void saiInteiro(EstadoGrandes *g, int b) {
+    int pos = g->blocos[b].pos_inteiro;
+    int topo = g->inteiros[--g->blocos_livres];
+    g->inteiros[pos] = topo;
+    g->blocos[topo].pos_inteiro = pos;
+    g->blocos[b].pos_inteiro = -1;
+}
+
+// Empilha o frame livre entre os de fora das reservas
+static void entraSolto(EstadoGrandes *g, int frame) {
+    g->pos_solto[frame] = g->num_soltos;
+    g->soltos[g->num_soltos++] = frame;
+}
+
+// Tira o frame dos de fora das reservas, pondo o do topo no lugar dele
+static void saiSolto(EstadoGrandes *g, int frame) {
+    int pos = g->pos_solto[frame];
+    int topo = g->soltos[--g->num_soltos];
+    g->soltos[pos] = topo;
+    g->pos_solto[topo] = pos;
+    g->pos_solto[frame] = -1;
+}
+
+// Recalcula posições nas pilhas e frames livres de cada bloco, sem nenhuma reserva
+static void reconstroiGrandes(MemoriaFisica *mem) {
+    EstadoGrandes *g = &mem->grandes;
+    for (int f = 0; f < mem->num_frames; f++) {
+        g->pos_livre[f] = -1;
+        g->pos_solto[f] = -1;
+        g->preenchida[f] = 0;
+    }
+    for (int b = 0; b < g->num_blocos; b++) {
+        BlocoGrande *bl = &g->blocos[b];
+        bl->pid = -1;
+        bl->regiao = -1;
+        bl->livres = bl->carregadas = bl->promovida = 0;
+        bl->pos_inteiro = -1;
+    }
+    g->num_soltos = 0;
+    for (int i = 0; i < mem->num_livres; i++) {
+        int frame = mem->livres[i];
+        g->pos_livre[frame] = i;
+        entraSolto(g, frame);
+        if (frame / g->fator < g->num_blocos)
+            g->blocos[frame / g->fator].livres++;
+    }
+    g->blocos_livres = 0;
+    for (int b = 0; b < g->num_blocos; b++) {
+        if (g->blocos[b].livres == g->fator)
+            entraInteiro(g, b);
+    }
+}
+
+// Aloca o estado para o fator (se ainda não existe) a partir da pilha de livres atual
+int preparaGrandes(MemoriaFisica *mem, int fator) {
+    EstadoGrandes *g = &mem->grandes;
+    if (g->blocos && g->fator == fator)
+        return 0;
+    liberaGrandes(mem);
+    g->fator = fator;
+    g->num_blocos = mem->num_frames / fator;
+    int num_blocos = g->num_blocos > 0 ? g->num_blocos : 1;
+    g->blocos = malloc(num_blocos * sizeof(BlocoGrande));
+    g->inteiros = malloc(num_blocos * sizeof(int));
+    g->soltos = malloc(mem->num_frames * sizeof(int));
+    g->pos_solto = malloc(mem->num_frames * sizeof(int));
+    g->pos_livre = malloc(mem->num_frames * sizeof(int));
+    g->preenchida = malloc(mem->num_frames);
+    if (!g->blocos || !g->inteiros || !g->soltos || !g->pos_solto || !g->pos_livre ||
+        !g->preenchida ||
+        mapaInicializa(&g->reservas, 16) != 0) {
+        liberaGrandes(mem);
+        return -1;
+    }
+    reconstroiGrandes(mem);
+    return 0;
+}
+
+// Desfaz todas as reservas (a pilha de livres já foi remontada)
+void reiniciaGrandes(MemoriaFisica *mem) {
+    if (!mem->grandes.blocos)
+        return;
+    mapaLimpa(&mem->grandes.reservas);
+    reconstroiGrandes(mem);
+}
+
+// Libera o estado (volta a ser montado no próximo acesso com páginas grandes)
+void liberaGrandes(MemoriaFisica *mem) {
+    EstadoGrandes *g = &mem->grandes;
+    free(g->blocos);
+    free(g->inteiros);
+    free(g->soltos);
+    free(g->pos_solto);
+    free(g->pos_livre);
+    free(g->preenchida);
+    mapaLibera(&g->reservas);
+    g->blocos = NULL;
+    g->inteiros = NULL;
+    g->soltos = NULL;
+    g->pos_solto = NULL;
+    g->pos_livre = NULL;
+    g->preenchida = NULL;
+    g->fator = 0;
+    g->num_blocos = 0;
+}
+
+// Registra o frame que acabou de entrar no topo da pilha de livres
+void livreEmpilhado(MemoriaFisica *mem, int frame) {
+    EstadoGrandes *g = &mem->grandes;
+    g->pos_livre[frame] = mem->num_livres - 1;
+    int b = frame / g->fator;
+    if (b >= g->num_blocos || g->blocos[b].pid == -1)
+        entraSolto(g, frame);
+    if (b < g->num_blocos && ++g->blocos[b].livres == g->fator && g->blocos[b].pid == -1)
+        entraInteiro(g, b);
+}
+
+// Tira o frame da pilha de livres, pondo o do topo no lugar dele
+static void retiraDaPilha(MemoriaFisica *mem, int frame) {
+    EstadoGrandes *g = &mem->grandes;
+    int pos = g->pos_livre[frame];
+    int topo = mem->livres[--mem->num_livres];
+    mem->livres[pos] = topo;
+    g->pos_livre[topo] = pos;
+    g->pos_livre[frame] = -1;
+    if (g->pos_solto[frame] >= 0)
+        saiSolto(g, frame);
+    int b = frame / g->fator;
+    if (b < g->num_blocos && g->blocos[b].livres-- == g->fator && g->blocos[b].pid == -1)
+        saiInteiro(g, b);
+}
+
+// Reserva para a região o bloco inteiro livre do topo da pilha; os frames dele deixam
+// de estar soltos. -1 se nenhum ou sem memória
+static int reservaBloco(Simulador *sim, int pid, int64_t regiao) {
+    EstadoGrandes *g = &sim->memoria.grandes;
+    if (g->blocos_livres == 0)
+        return -1;
+    int b = g->inteiros[g->blocos_livres - 1];
+    if (mapaInsere(&g->reservas, chavePagina(sim, pid, regiao), b) != 0)
+        return -1;
+    BlocoGrande *bl = &g->blocos[b];
+    saiInteiro(g, b);
+    bl->pid = pid;
+    bl->regiao = regiao;
+    bl->carregadas = 0;
+    bl->promovida = 0;
+    for (int s = 0; s < g->fator; s++)
+        saiSolto(g, b * g->fator + s);
+    return b;
+}
+
+// Abandona a reserva do bloco; os frames livres dele voltam ao uso geral e a página
+// grande, se havia, é rebaixada (a TLB perde a entrada dela)
+static void desfazReserva(Simulador *sim, int b) {
+    EstadoGrandes *g = &sim->memoria.grandes;
+    BlocoGrande *bl = &g->blocos[b];
+    uint64_t chave = chavePagina(sim, bl->pid, bl->regiao);
+    if (bl->promovida) {
+        invalidaTLB(&sim->tlb, chave, 1);
+        sim->rebaixamentos++;
+        if (sim->verbosidade >= VERBOSIDADE_FALTAS) {
+            INSTR_INICIO(t_impressao);
+            printf("Tempo t=%lld: [REBAIXAMENTO] Regiao %lld do Processo %d\n",
+                   (long long)sim->tempo_atual - 1, (long long)bl->regiao, bl->pid);
+            INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+        }
+    }
+    mapaRemove(&g->reservas, chave);
+    bl->pid = -1;
+    bl->regiao = -1;
+    bl->carregadas = 0;
+    bl->promovida = 0;
+    for (int s = 0, soltos = 0; soltos < bl->livres; s++) {
+        if (g->pos_livre[b * g->fator + s] >= 0) {
+            entraSolto(g, b * g->fator + s);
+            soltos++;
+        }
+    }
+    if (bl->livres == g->fator)
+        entraInteiro(g, b);
+    sim->reservas_desfeitas++;
+}
+
+// Retira da pilha o frame livre para a página (há ao menos um): o dela no bloco
+// reservado para a região, reservando um bloco inteiro livre se a região ainda não
+// tem; sem reserva, o do topo dos frames soltos e, se todos estão reservados, um da
+// reserva com menos páginas carregadas, que é desfeita (só nesse caso os blocos são
+// percorridos)
+int retiraLivreGrandes(Simulador *sim, int pid, int64_t num_pag) {
+    MemoriaFisica *mem = &sim->memoria;
+    EstadoGrandes *g = &mem->grandes;
+    int64_t regiao = num_pag / g->fator;
+    int64_t b;
+    if (!mapaBusca(&g->reservas, chavePagina(sim, pid, regiao), &b)) {
+        b = g->blocos_livres > 0 ? reservaBloco(sim, pid, regiao) : -1;
+        // Memória livre para um bloco, mas espalhada: fragmentação externa
+        if (b < 0 && mem->num_livres >= g->fator)
+            sim->faltas_sem_bloco++;
+    }
+    int frame = -1;
+    if (b >= 0 && g->pos_livre[b * g->fator + num_pag % g->fator] >= 0) {
+        frame = (int)(b * g->fator + num_pag % g->fator);
+        g->blocos[b].carregadas++;
+    }
+    if (frame < 0 && g->num_soltos > 0)
+        frame = g->soltos[g->num_soltos - 1];
+    if (frame < 0) {
+        int alvo = -1;
+        for (int k = 0; k < g->num_blocos; k++) {
+            const BlocoGrande *bl = &g->blocos[k];
+            if (bl->pid != -1 && bl->livres > 0 &&
+                (alvo < 0 || bl->carregadas < g->blocos[alvo].carregadas))
+                alvo = k;
+        }
+        desfazReserva(sim, alvo);
+        for (int s = 0; frame < 0; s++) {
+            if (g->pos_livre[alvo * g->fator + s] >= 0)
+                frame = alvo * g->fator + s;
+        }
+    }
+    retiraDaPilha(mem, frame);
+    return frame;
+}
+
+// A página do frame vai sair da memória: uma página de bloco reservado desfaz a
+// reserva (a região volta a páginas base)
+void paginaSaiuGrandes(Simulador *sim, int frame) {
+    EstadoGrandes *g = &sim->memoria.grandes;
+    g->preenchida[frame] = 0;
+    int b = frame / g->fator;
+    if (b < g->num_blocos && g->blocos[b].pid != -1)
+        desfazReserva(sim, b);
+}
+
+// Bloco da página grande que mapeia a página; -1 se a região não está promovida
+int blocoPromovido(const Simulador *sim, int pid, int64_t num_pag) {
+    const EstadoGrandes *g = &sim->memoria.grandes;
+    int64_t b;
+    if (!mapaBusca(&g->reservas, chavePagina(sim, pid, num_pag / g->fator), &b))
+        return -1;
+    return g->blocos[b].promovida ? (int)b : -1;
+}
+
+// Bloco da região da página se ela pode ser promovida: reservada, inteira dentro do
+// espaço do processo e com a fração limiar das páginas carregadas (o OPT não carrega
+// páginas sem pedido, então só promove regiões completas). -1 se não pode
+int blocoParaPromover(const Simulador *sim, const Processo *proc, int64_t num_pag, int algoritmo) {
+    const EstadoGrandes *g = &sim->memoria.grandes;
+    int64_t regiao = num_pag / g->fator;
+    int64_t b;
+    if ((regiao + 1) * g->fator > proc->num_paginas ||
+        !mapaBusca(&g->reservas, chavePagina(sim, proc->pid, regiao), &b))
+        return -1;
+    const BlocoGrande *bl = &g->blocos[b];
+    double minimo = algoritmo == ALG_OTIMO ? g->fator : sim->grandes.limiar * g->fator;
+    return !bl->promovida && bl->carregadas >= minimo ? (int)b : -1;
+}
+
+// Marca a região do bloco (já completa) como página grande; as traduções das páginas
+// base dela saem da TLB
+void marcaPromovida(Simulador *sim, int bloco) {
+    EstadoGrandes *g = &sim->memoria.grandes;
+    BlocoGrande *bl = &g->blocos[bloco];
+    bl->promovida = 1;
+    sim->promocoes++;
+    for (int s = 0; s < g->fator; s++)
+        invalidaTLB(&sim->tlb, chavePagina(sim, bl->pid, bl->regiao * g->fator + s), 0);
+    if (sim->verbosidade >= VERBOSIDADE_FALTAS) {
+        INSTR_INICIO(t_impressao);
+        printf("Tempo t=%lld: [PROMOCAO] Regiao %lld do Processo %d nos Frames %d a %d\n",
+               (long long)sim->tempo_atual - 1, (long long)bl->regiao, bl->pid,
+               bloco * g->fator, (bloco + 1) * g->fator - 1);
+        INSTR_FIM(FASE_IMPRESSAO, t_impressao);
+    }
+}
+
+// Primeiro acesso a uma página carregada só para completar a promoção
+void usaPreenchida(Simulador *sim, int frame) {
+    sim->memoria.grandes.preenchida[frame] = 0;
+    sim->preenchidas_usadas++;
+}
+
+// Regiões mapeadas agora por páginas grandes
+int regioesPromovidas(const Simulador *sim) {
+    const EstadoGrandes *g = &sim->memoria.grandes;
+    int n = 0;
+    for (int b = 0; b < g->num_blocos; b++)
+        n += g->blocos[b].promovida;
+    return n;
+}
+
+// Frames livres presos em reservas ainda não promovidas
+int framesReservadosLivres(const Simulador *sim) {
+    const EstadoGrandes *g = &sim->memoria.grandes;
+    int n = 0;
+    for (int b = 0; b < g->num_blocos; b++) {
+        if (g->blocos[b].pid != -1)
+            n += g->blocos[b].livres;
+    }
+    return n;
+}
+
+// Páginas carregadas na promoção que continuam na memória sem nenhum acesso
+// (fragmentação interna das páginas grandes)
+int paginasPreenchidasSemUso(const Simulador *sim) {
+    const EstadoGrandes *g = &sim->memoria.grandes;
+    int n = 0;
+    for (int f = 0; g->preenchida && f < sim->memoria.num_frames; f++)
+        n += g->preenchida[f];
+    return n;
+}
@@ -0,0 +1,28 @@
+#ifndef PAGINAS_GRANDES_H
+#define PAGINAS_GRANDES_H
+
+#include "estruturas.h"
+
+#define GRANDES_FATOR_MAX (1 << 20) // 4 GB com páginas de 4 KB
+
+// Páginas grandes ligadas na configuração (o estado é montado no primeiro acesso)
+#define grandesAtivas(sim) ((sim)->grandes.fator > 0)
+
+// Páginas grandes: reserva de blocos alinhados, promoção e rebaixamento
+int fatorPaginaGrande(int tamanho_grande, int tamanho_pagina);
+int configuraPaginasGrandes(Simulador *sim, const ParametrosPaginasGrandes *parametros);
+int preparaGrandes(MemoriaFisica *mem, int fator);
+void reiniciaGrandes(MemoriaFisica *mem);
+void liberaGrandes(MemoriaFisica *mem);
+void livreEmpilhado(MemoriaFisica *mem, int frame);
+int retiraLivreGrandes(Simulador *sim, int pid, int64_t num_pag);
+void paginaSaiuGrandes(Simulador *sim, int frame);
+int blocoPromovido(const Simulador *sim, int pid, int64_t num_pag);
+int blocoParaPromover(const Simulador *sim, const Processo *proc, int64_t num_pag, int algoritmo);
+void marcaPromovida(Simulador *sim, int bloco);
+void usaPreenchida(Simulador *sim, int frame);
+int regioesPromovidas(const Simulador *sim);
+int framesReservadosLivres(const Simulador *sim);
+int paginasPreenchidasSemUso(const Simulador *sim);
+
+#endif
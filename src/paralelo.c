@@ -0,0 +1,151 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "paralelo.h"
+#include "algoritmos.h"
+#include "tabela_paginas.h"
+#include "tlb.h"
+#include "antecipacao.h"
+#include "alocacao.h"
+#include "paginas_grandes.h"
+#include "comprimida.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+// Estado compartilhado entre as threads: trace somente leitura e fila de configurações
+typedef struct
+{
+    const AcessoTrace *acessos;
+    int64_t num_acessos;
+    ConfiguracaoSimulacao *configs;
+    int num_configs;
+    int proxima;           // Próxima configuração a ser retirada
+    pthread_mutex_t trava; // Protege 'proxima'
+} TrabalhoParalelo;
+
+// Tempo monotônico em segundos
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Número de núcleos disponíveis
+int numeroDeNucleos(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+// Roda uma configuração em um Simulador próprio, sem nenhuma saída
+static void simulaConfiguracao(const TrabalhoParalelo *trabalho, ConfiguracaoSimulacao *cfg) {
+    Simulador sim;
+    inicializarSimulador(&sim);
+    sim.verbosidade = VERBOSIDADE_SILENCIOSO;
+    sim.algoritmo = cfg->algoritmo;
+    sim.latencias = cfg->latencias;
+    sim.janela_limpas = cfg->janela_limpas;
+
+    double inicio = agora();
+    cfg->status = configuraMemoria(&sim, cfg->tamanho_pagina, cfg->tamanho_memoria_fisica);
+    if (cfg->status == 0)
+        cfg->status = configuraTabela(&sim, cfg->modo_tabela, cfg->niveis);
+    if (cfg->status == 0 && cfg->tlb.conjuntos[0] > 0)
+        cfg->status = configuraTLB(&sim.tlb, &cfg->tlb);
+    if (cfg->status == 0)
+        cfg->status = configuraAntecipacao(&sim, &cfg->antecipacao);
+    if (cfg->status == 0 && (configuraAlocacao(&sim, &cfg->alocacao) != 0 ||
+                             !alocacaoSuportada(cfg->alocacao.modo, cfg->algoritmo)))
+        cfg->status = -1;
+    if (cfg->status == 0 && cfg->pagina_grande > 0) {
+        ParametrosPaginasGrandes grandes = {
+            fatorPaginaGrande(cfg->pagina_grande, cfg->tamanho_pagina), cfg->limiar_promocao};
+        cfg->status = configuraPaginasGrandes(&sim, &grandes);
+    }
+    if (cfg->status == 0 && cfg->comprimida.capacidade > 0)
+        cfg->status = configuraComprimida(&sim, &cfg->comprimida);
+    if (cfg->status == 0 &&
+        executaAcessos(&sim, trabalho->acessos, trabalho->num_acessos) < 0)
+        cfg->status = -1;
+    cfg->segundos = agora() - inicio;
+
+    cfg->num_frames = sim.memoria.num_frames;
+    cfg->total_acessos = sim.total_acessos;
+    cfg->page_faults = sim.page_faults;
+    cfg->escritas_disco = sim.escritas_disco;
+    cfg->tempo_efetivo = tempoEfetivoAcesso(&sim);
+    cfg->antecipadas = sim.antecipadas;
+    cfg->antecipadas_uteis = sim.antecipadas_uteis;
+    cfg->antecipadas_atrasadas = sim.antecipadas_atrasadas;
+    cfg->antecipadas_desperdicadas = sim.antecipadas_desperdicadas;
+    cfg->intervalos = sim.intervalos;
+    cfg->intervalos_thrashing = sim.intervalos_thrashing;
+    cfg->faltas_sem_folga = sim.faltas_sem_folga;
+    cfg->promocoes = sim.promocoes;
+    cfg->rebaixamentos = sim.rebaixamentos;
+    cfg->faltas_sem_bloco = sim.faltas_sem_bloco;
+    cfg->preenchidas = sim.preenchidas;
+    cfg->preenchidas_usadas = sim.preenchidas_usadas;
+    cfg->tlb_hits_grandes = sim.hits_tlb_grandes;
+    cfg->comprimidas = sim.comprimidas;
+    cfg->rejeitadas = sim.rejeitadas;
+    cfg->faltas_comprimidas = sim.faltas_comprimidas;
+    cfg->descomprimidas = sim.descomprimidas;
+    cfg->devolvidas = sim.devolvidas;
+    cfg->devolvidas_gravadas = sim.devolvidas_gravadas;
+    cfg->pico_comprimida = sim.pico_comprimida;
+    cfg->tempo_comprimida = tempoComprimidaNs(&sim);
+    cfg->tempo_disco = tempoDiscoNs(&sim);
+    cfg->memoria_tabelas = memoriaTabelasPaginas(&sim);
+    for (int n = 0; n < 2; n++) {
+        cfg->tlb_hits[n] = sim.tlb.nivel[n].hits;
+        cfg->tlb_misses[n] = sim.tlb.nivel[n].misses;
+    }
+    liberarSimulador(&sim);
+}
+
+// Laço de cada thread: retira configurações até a fila acabar
+static void *trabalhador(void *arg) {
+    TrabalhoParalelo *trabalho = arg;
+    for (;;) {
+        pthread_mutex_lock(&trabalho->trava);
+        int i = trabalho->proxima++;
+        pthread_mutex_unlock(&trabalho->trava);
+        if (i >= trabalho->num_configs)
+            break;
+        simulaConfiguracao(trabalho, &trabalho->configs[i]);
+    }
+    return NULL;
+}
+
+// Simula todas as configurações sobre o mesmo trace usando num_threads threads
+int executaParalelo(const AcessoTrace *acessos, int64_t num_acessos,
+                    ConfiguracaoSimulacao *configs, int num_configs, int num_threads) {
+    TrabalhoParalelo trabalho = {acessos, num_acessos, configs, num_configs, 0,
+                                 PTHREAD_MUTEX_INITIALIZER};
+    if (num_threads > num_configs)
+        num_threads = num_configs;
+    if (num_threads < 1)
+        num_threads = 1;
+
+    pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+    if (!threads)
+        return -1;
+
+    // A thread principal também trabalha; cria as demais
+    int criadas = 0;
+    for (int t = 1; t < num_threads; t++) {
+        if (pthread_create(&threads[criadas], NULL, trabalhador, &trabalho) == 0)
+            criadas++;
+    }
+    trabalhador(&trabalho);
+    for (int t = 0; t < criadas; t++)
+        pthread_join(threads[t], NULL);
+
+    free(threads);
+    pthread_mutex_destroy(&trabalho.trava);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include "trace.h"
+
+// Uma configuração a simular e seus resultados
+typedef struct
+{
+    // Parâmetros
+    int algoritmo;              // ALG_*
+    int tamanho_pagina;         // Tamanho da página em bytes
+    int64_t tamanho_memoria_fisica; // Tamanho da memória física em bytes
+    int modo_tabela;            // TABELA_*
+    int niveis;                 // Níveis da tabela multinível
+    ParametrosTLB tlb;          // Geometria e política da TLB
+    LatenciasES latencias;      // Custos do tempo efetivo de acesso
+    int janela_limpas;          // Candidatas examinadas à procura de vítima limpa
+    ParametrosAntecipacao antecipacao; // Leitura antecipada
+    ParametrosAlocacao alocacao; // Alocação de frames entre processos
+    int pagina_grande;          // Tamanho da página grande em bytes (0 = desligadas)
+    double limiar_promocao;     // Fração da região carregada que dispara a promoção
+    ParametrosComprimida comprimida; // Memória comprimida (capacidade 0 = desligada)
+    // Resultados
+    int num_frames;
+    int64_t total_acessos;
+    int64_t page_faults;
+    int64_t escritas_disco;     // Vítimas modificadas gravadas no disco
+    double tempo_efetivo;       // Tempo efetivo de acesso em ns
+    int64_t antecipadas;        // Páginas lidas antecipadamente
+    int64_t antecipadas_uteis;
+    int64_t antecipadas_atrasadas;
+    int64_t antecipadas_desperdicadas;
+    int64_t intervalos;         // Intervalos da detecção de thrashing
+    int64_t intervalos_thrashing;
+    int64_t faltas_sem_folga;   // Faltas sem vítima fora das cotas ou working sets
+    int64_t promocoes;          // Regiões promovidas a página grande
+    int64_t rebaixamentos;
+    int64_t faltas_sem_bloco;   // Faltas sem bloco inteiro livre para reservar
+    int64_t preenchidas;        // Páginas carregadas para completar promoções
+    int64_t preenchidas_usadas;
+    int64_t tlb_hits_grandes;   // Hits da TLB em entradas de página grande
+    int64_t comprimidas;        // Páginas que entraram na memória comprimida
+    int64_t rejeitadas;         // Não comprimiram o bastante ou não couberam
+    int64_t faltas_comprimidas; // Faltas atendidas pela memória comprimida
+    int64_t descomprimidas;
+    int64_t devolvidas;         // Páginas que saíram do pool para o disco
+    int64_t devolvidas_gravadas;
+    int64_t pico_comprimida;    // Maior ocupação do pool em bytes
+    double tempo_comprimida;    // Tempo em compressões e descompressões (ns)
+    double tempo_disco;         // Tempo em leituras e gravações no disco (ns)
+    int64_t memoria_tabelas;    // Bytes das tabelas de páginas ao final
+    int64_t tlb_hits[2];        // Hits de cada nível da TLB
+    int64_t tlb_misses[2];
+    double segundos;            // Tempo de parede da simulação
+    int status;                 // 0 se a simulação terminou sem erro
+} ConfiguracaoSimulacao;
+
+int numeroDeNucleos(void);
+int executaParalelo(const AcessoTrace *acessos, int64_t num_acessos,
+                    ConfiguracaoSimulacao *configs, int num_configs, int num_threads);
+
+#endif
@@ -1,72 +1,261 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <limits.h>
 #include <locale.h>
+#include <time.h>
 #include "estruturas.h"
 #include "algoritmos.h"
+#include "tabela_paginas.h"
+#include "tlb.h"
+#include "antecipacao.h"
+#include "alocacao.h"
+#include "paginas_grandes.h"
+#include "comprimida.h"
+#include "estatisticas.h"
+#include "instantaneo.h"
+#include "trace.h"
+#include "escalonador.h"
+#include "varredura.h"
+#include "paralelo.h"
 
-// Inicializa o simulador com valores padrão
-void inicializarSimulador(Simulador *sim) {
-    sim->tempo_atual = 1;
-    sim->tamanho_pagina = 4096;        // 4KB por página
-    sim->tamanho_memoria_fisica = 12288; // 12KB de memória física
-    sim->num_processos = 0;
-    sim->processos = NULL;
-
-    // Calcula número de frames na memória física
-    sim->memoria.num_frames = sim->tamanho_memoria_fisica / sim->tamanho_pagina;
-    sim->memoria.frames = malloc(sim->memoria.num_frames * sizeof(int));
-    
-    // Inicializa todos os frames como livres (-1)
-    for (int i = 0; i < sim->memoria.num_frames; i++)
-        sim->memoria.frames[i] = -1;
-
-    // Inicializa estatísticas
-    sim->total_acessos = 0;
-    sim->page_faults = 0;
-    sim->algoritmo = 0;                // FIFO padrão
-}
-
-// Libera toda a memória alocada
-void liberarSimulador(Simulador *sim) {
-    // Libera tabelas de páginas de cada processo
-    for (int i = 0; i < sim->num_processos; i++) {
-        free(sim->processos[i].tabela_paginas);
-    }
-    free(sim->processos);
-    free(sim->memoria.frames);
+// Limpa a tela do terminal sem criar subprocesso
+static void limpaTela(void) {
+#ifdef _WIN32
+    system("cls");
+#else
+    printf("\033[H\033[2J");
+#endif
 }
 
 // Exibe cabeçalho com informações do simulador
 void drawHeader(const Simulador *sim) {
-    system("cls || clear");
-    const char *algoritmos[] = {"FIFO", "LRU"};
+    limpaTela();
     printf("===== SIMULADOR DE PAGINACAO =====\n");
     printf("Tamanho da pagina: %d bytes\n", sim->tamanho_pagina);
-    printf("Memoria fisica: %d bytes (%d frames)\n", 
-           sim->tamanho_memoria_fisica, sim->memoria.num_frames);
-    printf("Algoritmo: %s\n\n", algoritmos[sim->algoritmo]);
+    printf("Memoria fisica: %lld bytes (%d frames)\n", 
+           (long long)sim->tamanho_memoria_fisica, sim->memoria.num_frames);
+    printf("Algoritmo: %s\n", nomeAlgoritmo(sim->algoritmo));
+    if (sim->modo_tabela == TABELA_MULTINIVEL)
+        printf("Tabela de paginas: %s (%d niveis)\n\n", nomeModoTabela(sim->modo_tabela), sim->niveis);
+    else
+        printf("Tabela de paginas: %s\n\n", nomeModoTabela(sim->modo_tabela));
 }
 
 // Menu para seleção de algoritmo de substituição
 void menuAlgoritmo(Simulador *sim) {
-    system("cls || clear");
+    limpaTela();
     printf("===== SELECIONE O ALGORITMO =====\n");
     printf("0 - FIFO (First-In, First-Out)\n");
     printf("1 - LRU (Least Recently Used)\n");
+    printf("2 - CLOCK (Relogio)\n");
+    printf("3 - Segunda Chance\n");
+    printf("4 - CLOCK Melhorado (NRU)\n");
+    printf("5 - ARC (Adaptive Replacement Cache)\n");
+    printf("6 - 2Q\n");
+    printf("7 - LIRS (Low Inter-reference Recency Set)\n");
+    printf("8 - OPT (Belady, apenas para traces)\n");
     printf("Escolha: ");
     scanf("%d", &sim->algoritmo);
     
     // Valida entrada
-    if(sim->algoritmo < 0 || sim->algoritmo > 1) {
+    if(sim->algoritmo < 0 || sim->algoritmo >= NUM_ALGORITMOS) {
         printf("Selecao invalida! Usando FIFO.\n");
         sim->algoritmo = 0;
     }
+    // ARC, 2Q, LIRS e OPT só trabalham com a alocação global
+    if (!alocacaoSuportada(sim->alocacao.modo, sim->algoritmo)) {
+        printf("%s usa apenas a alocacao global.\n", nomeAlgoritmo(sim->algoritmo));
+        sim->alocacao.modo = ALOCA_GLOBAL;
+    }
     
     // Reinicia memória ao trocar algoritmo
     reinicializarMemoria(sim);
 }
 
+// Menu para seleção da organização da tabela de páginas
+static void menuTabela(Simulador *sim) {
+    int modo, niveis = sim->niveis;
+    limpaTela();
+    printf("===== TABELA DE PAGINAS =====\n");
+    printf("0 - Linear (uma entrada por pagina do processo)\n");
+    printf("1 - Multinivel (niveis alocados no primeiro acesso)\n");
+    printf("2 - Invertida (uma entrada por frame, com hash)\n");
+    printf("Escolha: ");
+    scanf("%d", &modo);
+    if (modo == TABELA_MULTINIVEL) {
+        printf("Niveis (%d a %d): ", NIVEIS_MIN, NIVEIS_MAX);
+        scanf("%d", &niveis);
+    }
+
+    // Recria as tabelas vazias no novo modo
+    if (configuraTabela(sim, modo, niveis) != 0) {
+        printf("Selecao invalida! Mantendo a tabela anterior.\n");
+        getchar();
+        getchar();
+    }
+}
+
+// Menu de configuração da TLB
+static void menuTLB(Simulador *sim) {
+    ParametrosTLB p = {{0, 0}, {1, 1}, TLB_LRU, 1};
+    limpaTela();
+    printf("===== TLB =====\n");
+    printf("Conjuntos do L1 (0 desliga a TLB): ");
+    scanf("%d", &p.conjuntos[0]);
+    if (p.conjuntos[0] > 0) {
+        printf("Vias do L1: ");
+        scanf("%d", &p.vias[0]);
+        printf("Conjuntos do L2 (0 = sem L2): ");
+        scanf("%d", &p.conjuntos[1]);
+        if (p.conjuntos[1] > 0) {
+            printf("Vias do L2: ");
+            scanf("%d", &p.vias[1]);
+        }
+        printf("Politica (0=LRU, 1=FIFO, 2=aleatoria): ");
+        scanf("%d", &p.politica);
+        printf("Marcar entradas com o pid (1) ou esvaziar na troca de processo (0): ");
+        scanf("%d", &p.asid);
+    }
+
+    if (configuraTLB(&sim->tlb, &p) != 0) {
+        printf("Parametros invalidos! Mantendo a TLB anterior.\n");
+        getchar();
+        getchar();
+    }
+}
+
+// Menu das latências de E/S e da preferência por vítimas limpas
+static void menuCustos(Simulador *sim) {
+    LatenciasES l = sim->latencias;
+    int janela;
+    limpaTela();
+    printf("===== CUSTOS DE E/S =====\n");
+    printf("Latencias atuais (ns): memoria %.0f, falta %.0f, escrita %.0f\n",
+           sim->latencias.memoria, sim->latencias.falta, sim->latencias.escrita);
+    printf("Latencia de acesso a memoria (ns): ");
+    scanf("%lf", &l.memoria);
+    printf("Latencia de leitura em page fault (ns): ");
+    scanf("%lf", &l.falta);
+    printf("Latencia de gravacao de pagina modificada (ns): ");
+    scanf("%lf", &l.escrita);
+    printf("Vitimas examinadas a procura de pagina limpa (0 = nao preferir): ");
+    scanf("%d", &janela);
+
+    if (l.memoria < 0 || l.falta < 0 || l.escrita < 0 || janela < 0) {
+        printf("Valores invalidos! Mantendo os anteriores.\n");
+        getchar();
+        getchar();
+        return;
+    }
+    sim->latencias = l;
+    sim->janela_limpas = janela;
+}
+
+// Menu da leitura antecipada
+static void menuAntecipacao(Simulador *sim) {
+    ParametrosAntecipacao p = sim->antecipacao;
+    limpaTela();
+    printf("===== LEITURA ANTECIPADA =====\n");
+    printf("0 - Nenhuma (so paginacao sob demanda)\n");
+    printf("1 - Sequencial (as N paginas seguintes)\n");
+    printf("2 - Passo (N paginas no passo detectado em cada processo)\n");
+    printf("3 - Adaptativa (janela de ate N paginas que cresce em fluxo sequencial)\n");
+    printf("Escolha: ");
+    scanf("%d", &p.politica);
+    if (p.politica != ANTECIPA_NENHUMA) {
+        printf("Paginas N (1 a %d): ", ANTECIPA_PAGINAS_MAX);
+        scanf("%d", &p.paginas);
+    }
+
+    if (configuraAntecipacao(sim, &p) != 0) {
+        printf("Selecao invalida! Mantendo a leitura antecipada anterior.\n");
+        getchar();
+        getchar();
+    }
+}
+
+// Menu da alocação de frames entre processos
+static void menuAlocacao(Simulador *sim) {
+    ParametrosAlocacao p = sim->alocacao;
+    limpaTela();
+    printf("===== ALOCACAO DE FRAMES =====\n");
+    printf("0 - Global (todos os processos disputam todos os frames)\n");
+    printf("1 - Fixa (parte igual para cada processo)\n");
+    printf("2 - Proporcional (ao numero de paginas do processo)\n");
+    printf("3 - Working set (paginas usadas nos ultimos D acessos do processo)\n");
+    printf("4 - PFF (cota cresce com faltas a menos de T acessos uma da outra)\n");
+    printf("Escolha: ");
+    scanf("%d", &p.modo);
+    printf("Janela D ou T, tambem intervalo da deteccao de thrashing (acessos): ");
+    scanf("%d", &p.janela);
+
+    if (!alocacaoSuportada(p.modo, sim->algoritmo) || configuraAlocacao(sim, &p) != 0) {
+        printf("Selecao invalida (alocacao local so com FIFO, LRU e relogios)! "
+               "Mantendo a anterior.\n");
+        getchar();
+        getchar();
+    }
+}
+
+// Menu das páginas grandes
+static void menuPaginasGrandes(Simulador *sim) {
+    ParametrosPaginasGrandes p = sim->grandes;
+    int tamanho;
+    limpaTela();
+    printf("===== PAGINAS GRANDES =====\n");
+    printf("Tamanho da pagina grande em bytes (0 desliga): ");
+    scanf("%d", &tamanho);
+    p.fator = 0;
+    if (tamanho != 0) {
+        p.fator = fatorPaginaGrande(tamanho, sim->tamanho_pagina);
+        printf("Fracao da regiao carregada que dispara a promocao (0 a 1): ");
+        scanf("%lf", &p.limiar);
+    }
+
+    if (p.fator < 0 || configuraPaginasGrandes(sim, &p) != 0) {
+        printf("Parametros invalidos (a pagina grande deve ser a pagina vezes uma potencia "
+               "de 2)! Mantendo os anteriores.\n");
+        getchar();
+        getchar();
+    }
+}
+
+// Menu da memória comprimida
+static void menuComprimida(Simulador *sim) {
+    ParametrosComprimida p = sim->comprimida;
+    LatenciasES l = sim->latencias;
+    long long capacidade;
+    limpaTela();
+    printf("===== MEMORIA COMPRIMIDA =====\n");
+    printf("Capacidade em bytes (0 desliga): ");
+    scanf("%lld", &capacidade);
+    p.capacidade = capacidade;
+    if (capacidade > 0) {
+        p.num_razoes = 1;
+        p.acumuladas[0] = 1.0;
+        printf("Razao de compressao (tamanho original / comprimido): ");
+        scanf("%lf", &p.razoes[0]);
+        printf("Latencia de compressao (ns): ");
+        scanf("%lf", &l.compressao);
+        printf("Latencia de descompressao (ns): ");
+        scanf("%lf", &l.descompressao);
+    }
+
+    if (l.compressao < 0 || l.descompressao < 0 || configuraComprimida(sim, &p) != 0) {
+        printf("Parametros invalidos! Mantendo os anteriores.\n");
+        getchar();
+        getchar();
+        return;
+    }
+    sim->latencias = l;
+}
+
 // Menu de configuração de parâmetros
 void menuParametros(Simulador *sim) {
     int opcao;
@@ -76,66 +265,1149 @@ void menuParametros(Simulador *sim) {
         printf("1. Tamanho da pagina\n");
         printf("2. Tamanho da memoria fisica\n");
         printf("3. Algoritmo de substituicao\n");
+        printf("4. Tabela de paginas\n");
+        printf("5. TLB\n");
+        printf("6. Custos de E/S\n");
+        printf("7. Leitura antecipada\n");
+        printf("8. Alocacao de frames\n");
+        printf("9. Paginas grandes\n");
+        printf("10. Memoria comprimida\n");
         printf("0. Voltar\n");
         printf("Escolha: ");
         scanf("%d", &opcao);
         
+        int tam_pagina = sim->tamanho_pagina;
+        long long tam_memoria = sim->tamanho_memoria_fisica;
         switch(opcao) {
             case 1:
                 printf("Novo tamanho (bytes): ");
-                scanf("%d", &sim->tamanho_pagina);
+                scanf("%d", &tam_pagina);
                 break;
             case 2:
                 printf("Novo tamanho (bytes): ");
-                scanf("%d", &sim->tamanho_memoria_fisica);
+                scanf("%lld", &tam_memoria);
                 break;
             case 3:
                 menuAlgoritmo(sim);
                 break;
+            case 4:
+                menuTabela(sim);
+                break;
+            case 5:
+                menuTLB(sim);
+                break;
+            case 6:
+                menuCustos(sim);
+                break;
+            case 7:
+                menuAntecipacao(sim);
+                break;
+            case 8:
+                menuAlocacao(sim);
+                break;
+            case 9:
+                menuPaginasGrandes(sim);
+                break;
+            case 10:
+                menuComprimida(sim);
+                break;
         }
         
         // Recalcula frames se parâmetros mudaram
-        int novos_frames = sim->tamanho_memoria_fisica / sim->tamanho_pagina;
-        if(novos_frames != sim->memoria.num_frames) {
-            sim->memoria.num_frames = novos_frames;
-            free(sim->memoria.frames);
-            sim->memoria.frames = malloc(sim->memoria.num_frames * sizeof(int));
-            reinicializarMemoria(sim);
+        if (configuraMemoria(sim, tam_pagina, tam_memoria) != 0) {
+            printf("Parametros invalidos! Mantendo os anteriores.\n");
+            getchar();
+            getchar();
         }
     } while(opcao != 0);
 }
 
-int main() {
-    setlocale(LC_ALL, "Portuguese");
-    Simulador sim;
-    inicializarSimulador(&sim);
-    
-    // Configuração de processo de exemplo
-    sim.num_processos = 1;
-    sim.processos = malloc(sizeof(Processo));
-    sim.processos[0].pid = 1;
-    sim.processos[0].num_paginas = 8;
-    // Aloca e inicializa tabela de páginas
-    sim.processos[0].tabela_paginas = calloc(8, sizeof(Pagina));
+// Exibe resultados finais da simulação
+static void imprimeResultados(const Simulador *sim) {
+    if (sim->verbosidade < VERBOSIDADE_RESUMO)
+        return;
+    printf("\n===== RESULTADOS =====\n");
+    printf("Total de acessos: %lld\n", (long long)sim->total_acessos);
+    printf("Page faults: %lld\n", (long long)sim->page_faults);
+    printf("Taxa de page faults: %.2f%%\n", 
+           sim->total_acessos ? (sim->page_faults * 100.0) / sim->total_acessos : 0.0);
+    printf("Paginas modificadas gravadas no disco: %lld\n", (long long)sim->escritas_disco);
+    if (sim->antecipacao.politica != ANTECIPA_NENHUMA)
+        printf("Leitura antecipada (%s, %d paginas): %lld lidas, %lld uteis (%lld atrasadas), "
+               "%lld desperdicadas\n", nomePoliticaAntecipacao(sim->antecipacao.politica),
+               sim->antecipacao.paginas, (long long)sim->antecipadas,
+               (long long)sim->antecipadas_uteis, (long long)sim->antecipadas_atrasadas,
+               (long long)sim->antecipadas_desperdicadas);
+    printf("Tempo efetivo de acesso: %.1f ns\n", tempoEfetivoAcesso(sim));
+    printf("Memoria das tabelas de paginas: %lld bytes\n",
+           (long long)memoriaTabelasPaginas(sim));
+
+    // Hits e misses da TLB são contados à parte dos page faults
+    const TLB *tlb = &sim->tlb;
+    for (int n = 0; n < 2; n++) {
+        const NivelTLB *nivel = &tlb->nivel[n];
+        int64_t consultas = nivel->hits + nivel->misses;
+        if (tlb->parametros.conjuntos[n] > 0)
+            printf("TLB L%d (%dx%d, %s): %lld hits, %lld misses (%.2f%% de hits)\n", n + 1,
+                   tlb->parametros.conjuntos[n], tlb->parametros.vias[n],
+                   nomePoliticaTLB(tlb->parametros.politica), (long long)nivel->hits,
+                   (long long)nivel->misses,
+                   consultas ? nivel->hits * 100.0 / consultas : 0.0);
+    }
+    if (tlb->parametros.conjuntos[0] > 0 && !tlb->parametros.asid)
+        printf("TLB esvaziada em %lld trocas de processo\n", (long long)tlb->esvaziamentos);
+
+    // Páginas grandes: alcance da TLB com elas e as duas fragmentações
+    if (grandesAtivas(sim)) {
+        int fator = sim->grandes.fator;
+        printf("Paginas grandes de %lld bytes (%d paginas, promocao com %.0f%% da regiao): "
+               "%lld promocoes, %lld rebaixamentos, %d promovidas agora\n",
+               (long long)fator * sim->tamanho_pagina, fator, sim->grandes.limiar * 100.0,
+               (long long)sim->promocoes, (long long)sim->rebaixamentos, regioesPromovidas(sim));
+        for (int n = 0; n < 2; n++) {
+            if (tlb->parametros.conjuntos[n] > 0)
+                printf("Alcance da TLB L%d: %lld bytes (%lld hits em paginas grandes no total)\n",
+                       n + 1, (long long)alcanceTLB(tlb, n, fator) * sim->tamanho_pagina,
+                       (long long)sim->hits_tlb_grandes);
+        }
+        printf("Fragmentacao interna: %lld paginas carregadas para completar promocoes, %lld "
+               "usadas depois, %d na memoria sem uso; %d frames livres presos em reservas\n",
+               (long long)sim->preenchidas, (long long)sim->preenchidas_usadas,
+               paginasPreenchidasSemUso(sim), framesReservadosLivres(sim));
+        printf("Fragmentacao externa: %lld faltas sem bloco livre inteiro (com %d frames "
+               "livres ou mais); %lld reservas desfeitas\n", (long long)sim->faltas_sem_bloco,
+               fator, (long long)sim->reservas_desfeitas);
+    }
+
+    // Memória comprimida: tráfego e tempo em cada nível
+    if (comprimidaAtiva(sim)) {
+        const EstadoComprimida *c = &sim->memoria.comprimida;
+        printf("Memoria comprimida de %lld bytes (razao esperada %.2f): %lld paginas "
+               "comprimidas, %lld rejeitadas; %d no pool agora (%lld bytes, pico de %lld)\n",
+               (long long)sim->comprimida.capacidade, razaoMediaCompressao(&sim->comprimida),
+               (long long)sim->comprimidas, (long long)sim->rejeitadas, c->num_paginas,
+               (long long)c->bytes, (long long)sim->pico_comprimida);
+        printf("Leituras: %lld faltas atendidas pela memoria comprimida (%.2f%% das faltas), "
+               "%lld pelo disco; %lld paginas descomprimidas\n",
+               (long long)sim->faltas_comprimidas,
+               sim->page_faults ? sim->faltas_comprimidas * 100.0 / sim->page_faults : 0.0,
+               (long long)(sim->page_faults - sim->faltas_comprimidas),
+               (long long)sim->descomprimidas);
+        printf("Gravacoes: %lld paginas devolvidas ao disco pela memoria comprimida, %lld "
+               "delas gravadas\n", (long long)sim->devolvidas,
+               (long long)sim->devolvidas_gravadas);
+        printf("Tempo por nivel: memoria %.0f ns, memoria comprimida %.0f ns, disco %.0f ns\n",
+               sim->total_acessos * sim->latencias.memoria, tempoComprimidaNs(sim),
+               tempoDiscoNs(sim));
+    }
+
+    // Faltas e frames de cada processo, com vários processos ou alocação local
+    const ParametrosAlocacao *aloc = &sim->alocacao;
+    if (sim->num_processos > 1 || aloc->modo != ALOCA_GLOBAL) {
+        printf("Alocacao de frames: %s\n", nomeModoAlocacao(aloc->modo));
+        printf("%8s %12s %12s %8s %8s %8s\n", "Processo", "Acessos", "Faults", "Taxa", "Frames",
+               "Cota");
+        for (int i = 0; i < sim->num_processos; i++) {
+            const Processo *proc = &sim->processos[i];
+            printf("%8d %12lld %12lld %7.2f%% %8d", proc->pid, (long long)proc->acessos,
+                   (long long)proc->faltas,
+                   proc->acessos ? proc->faltas * 100.0 / proc->acessos : 0.0, proc->residentes);
+            // No working set a coluna mostra o tamanho atual do conjunto
+            if (aloc->modo == ALOCA_GLOBAL)
+                printf(" %8s\n", "-");
+            else if (aloc->modo == ALOCA_WORKING_SET)
+                printf(" %8d\n", tamanhoWorkingSet(sim, proc));
+            else
+                printf(" %8d\n", proc->cota);
+        }
+    }
+    if (sim->intervalos > 0)
+        printf("Intervalos de %d acessos com mais de %.0f%% de substituicoes: %lld de %lld%s\n",
+               aloc->janela, aloc->limiar_thrashing * 100.0, (long long)sim->intervalos_thrashing,
+               (long long)sim->intervalos, emThrashing(sim) ? " (THRASHING)" : "");
+    if (sim->faltas_sem_folga > 0)
+        printf("Faltas sem vitima fora das cotas ou working sets: %lld\n",
+               (long long)sim->faltas_sem_folga);
+}
+
+// Reproduz um arquivo de trace escolhido pelo usuário
+static void menuTrace(Simulador *sim) {
+    char caminho[256];
+    drawHeader(sim);
+    printf("===== TRACE =====\n");
+    printf("Formato texto: uma linha \"pid R|W endereco\" por acesso\n");
+    printf("Formato binario: gerado pela opcao de conversao\n");
+    printf("Arquivo: ");
+    if (scanf("%255s", caminho) != 1)
+        return;
+
+    LeitorTrace leitor;
+    if (abreTrace(&leitor, caminho) == 0) {
+        reinicializarMemoria(sim);
+        int64_t executados = executaTrace(sim, &leitor);
+        fechaTrace(&leitor);
+        if (executados < 0)
+            printf("Trace interrompido por erro.\n");
+        imprimeResultados(sim);
+    }
+
+    printf("\nPressione ENTER para continuar...");
+    getchar();
+    getchar();
+}
+
+// Converte um trace texto para o formato binário compacto
+static void menuConverteTrace(Simulador *sim) {
+    char origem[256], destino[256];
+    drawHeader(sim);
+    printf("===== CONVERTER TRACE =====\n");
+    printf("Arquivo de origem: ");
+    if (scanf("%255s", origem) != 1)
+        return;
+    printf("Arquivo binario de destino: ");
+    if (scanf("%255s", destino) != 1)
+        return;
+    if (converteTrace(origem, destino) == 0)
+        printf("Trace convertido.\n");
+
+    printf("\nPressione ENTER para continuar...");
+    getchar();
+    getchar();
+}
+
+// Formatos de saída dos resultados no modo de linha de comando
+#define SAIDA_TEXTO 0
+#define SAIDA_CSV   1
+#define SAIDA_JSON  2
+
+// Máximo de valores em uma lista de opção (ex: --memoria 16K,32K,64K)
+#define MAX_VALORES_OPCAO 64
+
+// Opções que definem a estrutura do estado simulado (com --restaura-estado ela vem do arquivo)
+static const char *const opcoes_estruturais[] = {
+    "-p", "--pagina", "-m", "--memoria", "-a", "--algoritmo", "--tabela", "--niveis", "--tlb",
+    "--tlb2", "--tlb-politica", "--tlb-sem-asid", "--alocacao", "--janela-alocacao",
+    "--paginas-grandes", "--memoria-comprimida", NULL};
+
+// Parâmetros que podem mudar sobre um estado restaurado (o bit i de
+// OpcoesLinhaComando.ajustadas marca opcoes_ajustaveis[i])
+static const char *const opcoes_ajustaveis[] = {
+    "--latencia-memoria", "--latencia-falta", "--latencia-escrita", "--preferir-limpas",
+    "--antecipacao", "--antecipacao-paginas", "--limiar-thrashing", "--limiar-promocao",
+    "--razao-compressao", "--latencia-compressao", "--latencia-descompressao", NULL};
+
+// Opções lidas da linha de comando
+typedef struct
+{
+    // Listas de valores; com mais de um valor em alguma lista (ou com
+    // --paralelo) simula todas as combinações em paralelo
+    int tamanhos_pagina[MAX_VALORES_OPCAO];
+    int num_tamanhos_pagina;    // 0 mantém o padrão
+    int64_t tamanhos_memoria[MAX_VALORES_OPCAO];
+    int num_tamanhos_memoria;   // 0 mantém o padrão
+    int algoritmos[MAX_VALORES_OPCAO];
+    int num_algoritmos;         // 0 mantém o padrão
+    int threads;                // Threads do modo paralelo (0 = um por núcleo, -1 = desligado)
+    int verbosidade;            // -1 usa o padrão do modo
+    int formato;                // SAIDA_*
+    int cabecalho_csv;          // 0 omite o cabeçalho do CSV
+    const char *trace;          // Trace a reproduzir (NULL se nenhum)
+    const char *processos[MAX_VALORES_OPCAO]; // Um trace por processo, intercalados
+    int num_processos;          // 0 sem --processos
+    int quantum;                // Acessos de cada processo por vez na intercalação
+    int varredura;              // 1 para calcular a curva do LRU para todos os tamanhos
+    int modo_tabela;            // TABELA_* (-1 mantém o padrão)
+    int niveis;                 // Níveis da tabela multinível (0 mantém o padrão)
+    ParametrosTLB tlb;          // conjuntos[0] = 0 deixa a TLB desligada
+    LatenciasES latencias;      // Custos do tempo efetivo de acesso
+    int janela_limpas;          // Candidatas examinadas à procura de vítima limpa
+    ParametrosAntecipacao antecipacao; // Leitura antecipada
+    ParametrosAlocacao alocacao; // Alocação de frames entre processos
+    int pagina_grande;          // Tamanho da página grande em bytes (0 = desligadas)
+    double limiar_promocao;     // Fração da região carregada que dispara a promoção
+    ParametrosComprimida comprimida; // Memória comprimida (capacidade 0 = desligada)
+    const char *estatisticas;   // Arquivo das estatísticas detalhadas (NULL se nenhum)
+    int janela_serie;           // Acessos por ponto da série de taxa de faltas
+    const char *eventos;        // Log binário de eventos (NULL se nenhum)
+    const char *converter_origem;  // Conversão de trace (--converte)
+    const char *converter_destino;
+    const char *salva_estado;   // Arquivo do estado gravado ao fim (NULL se nenhum)
+    int64_t salva_a_cada;       // Também grava o estado a cada N acessos (0 = só ao fim)
+    const char *restaura_estado; // Estado de partida (NULL começa com a memória vazia)
+    int estruturais;            // Opções de opcoes_estruturais presentes
+    unsigned ajustadas;         // Opções de opcoes_ajustaveis presentes, uma por bit
+} OpcoesLinhaComando;
+
+// Exibe as opções da linha de comando
+static void imprimeUso(const char *programa) {
+    fprintf(stderr, "Uso: %s [opcoes]\n", programa);
+    fprintf(stderr, "Sem --trace abre o menu interativo.\n\n");
+    fprintf(stderr, "  -p, --pagina TAM[,TAM]  tamanho da pagina (aceita K, M, G)\n");
+    fprintf(stderr, "  -m, --memoria TAM[,TAM] tamanho da memoria fisica (aceita K, M, G)\n");
+    fprintf(stderr, "  -a, --algoritmo ALG[,ALG]  fifo | lru | clock | segunda-chance |\n");
+    fprintf(stderr, "                          clock-melhorado | arc | 2q | lirs | opt | todos\n");
+    fprintf(stderr, "      --tabela MODO       linear | multinivel | invertida (padrao: linear)\n");
+    fprintf(stderr, "      --niveis N          niveis da tabela multinivel, de %d a %d (padrao: %d)\n",
+            NIVEIS_MIN, NIVEIS_MAX, NIVEIS_PADRAO);
+    fprintf(stderr, "      --tlb CxV           TLB L1 com C conjuntos de V vias (ex: 16x4)\n");
+    fprintf(stderr, "      --tlb2 CxV          segundo nivel da TLB\n");
+    fprintf(stderr, "      --tlb-politica POL  lru | fifo | aleatoria (padrao: lru)\n");
+    fprintf(stderr, "      --tlb-sem-asid      esvazia a TLB a cada troca de processo\n");
+    fprintf(stderr, "      --latencia-memoria NS  custo de um acesso a memoria (padrao: %.0f)\n",
+            LATENCIA_MEMORIA_PADRAO);
+    fprintf(stderr, "      --latencia-falta NS    custo de ler a pagina em um page fault\n");
+    fprintf(stderr, "                          (padrao: %.0f)\n", LATENCIA_FALTA_PADRAO);
+    fprintf(stderr, "      --latencia-escrita NS  custo de gravar uma vitima modificada\n");
+    fprintf(stderr, "                          (padrao: %.0f)\n", LATENCIA_ESCRITA_PADRAO);
+    fprintf(stderr, "      --preferir-limpas N examina ate N vitimas a procura de pagina limpa\n");
+    fprintf(stderr, "      --antecipacao POL   leitura antecipada: nenhuma | sequencial | passo |\n");
+    fprintf(stderr, "                          adaptativa (padrao: nenhuma)\n");
+    fprintf(stderr, "      --antecipacao-paginas N  paginas por falta, de 1 a %d (padrao: %d)\n",
+            ANTECIPA_PAGINAS_MAX, ANTECIPA_PAGINAS_PADRAO);
+    fprintf(stderr, "      --processos ARQ[,ARQ]  um trace por processo (o i-esimo vira o\n");
+    fprintf(stderr, "                          processo i), intercalados em rodizio\n");
+    fprintf(stderr, "      --quantum N         acessos de cada processo por vez (padrao: %d)\n",
+            QUANTUM_PADRAO);
+    fprintf(stderr, "      --alocacao MODO     global | fixa | proporcional | ws | pff\n");
+    fprintf(stderr, "                          (padrao: global)\n");
+    fprintf(stderr, "      --janela-alocacao N janela do working set, intervalo do PFF e da\n");
+    fprintf(stderr, "                          deteccao de thrashing, em acessos (padrao: %d)\n",
+            ALOCA_JANELA_PADRAO);
+    fprintf(stderr, "      --limiar-thrashing F  fracao de substituicoes por acesso que marca\n");
+    fprintf(stderr, "                          o intervalo como thrashing (padrao: %.2f)\n",
+            ALOCA_LIMIAR_PADRAO);
+    fprintf(stderr, "      --paginas-grandes TAM  paginas grandes de TAM bytes (pagina vezes\n");
+    fprintf(stderr, "                          potencia de 2, ex: 2M): regioes densas sao\n");
+    fprintf(stderr, "                          promovidas a uma entrada de TLB\n");
+    fprintf(stderr, "      --limiar-promocao F fracao da regiao carregada que dispara a\n");
+    fprintf(stderr, "                          promocao (padrao: %.2f)\n", GRANDES_LIMIAR_PADRAO);
+    fprintf(stderr, "      --memoria-comprimida TAM  pool de TAM bytes entre a memoria e o\n");
+    fprintf(stderr, "                          disco para as paginas que saem (zswap)\n");
+    fprintf(stderr, "      --razao-compressao R[:P][,R:P]  razao de compressao das paginas,\n");
+    fprintf(stderr, "                          ou razoes com pesos (padrao: %.0f)\n",
+            COMPRIMIDA_RAZAO_PADRAO);
+    fprintf(stderr, "      --latencia-compressao NS    custo de comprimir uma pagina\n");
+    fprintf(stderr, "                          (padrao: %.0f)\n", LATENCIA_COMPRESSAO_PADRAO);
+    fprintf(stderr, "      --latencia-descompressao NS custo de descomprimir uma pagina\n");
+    fprintf(stderr, "                          (padrao: %.0f)\n", LATENCIA_DESCOMPRESSAO_PADRAO);
+    fprintf(stderr, "      --estatisticas ARQ  grava estatisticas por processo, por frame,\n");
+    fprintf(stderr, "                          intervalo entre faltas, serie temporal e\n");
+    fprintf(stderr, "                          motivos de expulsao (JSON se ARQ termina em\n");
+    fprintf(stderr, "                          .json, senao CSV)\n");
+    fprintf(stderr, "      --janela-serie N    acessos por ponto da serie (padrao: %d)\n",
+            ESTAT_JANELA_PADRAO);
+    fprintf(stderr, "      --eventos ARQ       grava um registro binario por evento\n");
+    fprintf(stderr, "      --salva-estado ARQ  grava o estado da simulacao ao fim do trace\n");
+    fprintf(stderr, "      --salva-a-cada N    tambem grava o estado a cada N acessos\n");
+    fprintf(stderr, "      --restaura-estado ARQ  parte do estado gravado e continua o trace\n");
+    fprintf(stderr, "                          depois do ultimo acesso reproduzido nele\n");
+    fprintf(stderr, "  -j, --paralelo N        simula todas as combinacoes das listas em N\n");
+    fprintf(stderr, "                          threads (0 = um por nucleo)\n");
+    fprintf(stderr, "  -t, --trace ARQ         reproduz o trace e encerra ('-' = entrada padrao)\n");
+    fprintf(stderr, "  -s, --varredura         com --trace: curva de faults do LRU para todo\n");
+    fprintf(stderr, "                          numero de frames, em uma unica passada\n");
+    fprintf(stderr, "  -f, --formato FMT       texto | csv | json (padrao: texto)\n");
+    fprintf(stderr, "      --sem-cabecalho     omite o cabecalho do CSV\n");
+    fprintf(stderr, "  -c, --converte ORIG DEST  converte trace para binario e encerra\n");
+    fprintf(stderr, "  -v, --verbosidade N     0=silencioso 1=resumo 2=page faults 3=completo\n");
+    fprintf(stderr, "  -q, --silencioso        o mesmo que -v 0\n");
+    fprintf(stderr, "  -h, --ajuda             mostra esta ajuda\n");
+}
+
+// Posição de arg na lista terminada em NULL; -1 se não está nela
+static int posicaoNaLista(const char *arg, const char *const *lista) {
+    for (int i = 0; lista[i]; i++) {
+        if (strcmp(arg, lista[i]) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Converte tamanho em bytes com sufixo opcional K/M/G; retorna -1 se inválido. A faixa
+// é conferida antes de multiplicar, para o sufixo não estourar o valor
+static int64_t leBytes(const char *texto) {
+    char *fim;
+    errno = 0;
+    long long valor = strtoll(texto, &fim, 10);
+    long long multiplicador = 1;
+    switch (*fim) {
+        case 'k': case 'K': multiplicador = 1024LL; fim++; break;
+        case 'm': case 'M': multiplicador = 1024LL * 1024; fim++; break;
+        case 'g': case 'G': multiplicador = 1024LL * 1024 * 1024; fim++; break;
+    }
+    if (fim == texto || *fim != '\0' || errno == ERANGE || valor <= 0 ||
+        valor > INT64_MAX / multiplicador)
+        return -1;
+    return (int64_t)valor * multiplicador;
+}
+
+// Como leBytes, para tamanhos que cabem em int
+static int leTamanho(const char *texto) {
+    int64_t valor = leBytes(texto);
+    return (valor < 0 || valor > INT_MAX) ? -1 : (int)valor;
+}
+
+// Separa lista por vírgulas em copia; retorna o número de itens ou -1 se inválida
+static int separaLista(const char *texto, char *copia, size_t tamanho, char **itens) {
+    if (strlen(texto) >= tamanho)
+        return -1;
+    strcpy(copia, texto);
+
+    int n = 0;
+    for (char *item = strtok(copia, ","); item; item = strtok(NULL, ",")) {
+        if (n == MAX_VALORES_OPCAO)
+            return -1;
+        itens[n++] = item;
+    }
+    return n > 0 ? n : -1;
+}
+
+// Lê lista separada por vírgulas; retorna o número de valores ou -1 se inválida
+static int leLista(const char *texto, int (*converte)(const char *), int *valores) {
+    char copia[512], *itens[MAX_VALORES_OPCAO];
+    int n = separaLista(texto, copia, sizeof(copia), itens);
+    for (int i = 0; i < n; i++) {
+        if ((valores[i] = converte(itens[i])) < 0)
+            return -1;
+    }
+    return n;
+}
+
+// Lê lista de tamanhos em bytes (podem passar de 2 GB); retorna o número ou -1
+static int leListaBytes(const char *texto, int64_t *valores) {
+    char copia[512], *itens[MAX_VALORES_OPCAO];
+    int n = separaLista(texto, copia, sizeof(copia), itens);
+    for (int i = 0; i < n; i++) {
+        if ((valores[i] = leBytes(itens[i])) < 0)
+            return -1;
+    }
+    return n;
+}
+
+// Lê a geometria da TLB no formato CONJUNTOSxVIAS; retorna -1 se inválida
+static int leGeometriaTLB(const char *texto, int *conjuntos, int *vias) {
+    char x;
+    if (sscanf(texto, "%d%c%d", conjuntos, &x, vias) != 3 || (x != 'x' && x != 'X') ||
+        *conjuntos <= 0 || *vias <= 0)
+        return -1;
+    return 0;
+}
+
+// Lê uma latência em nanossegundos; retorna -1 se inválida
+static int leLatencia(const char *texto, double *latencia) {
+    char *fim;
+    *latencia = strtod(texto, &fim);
+    return (fim == texto || *fim != '\0' || *latencia < 0) ? -1 : 0;
+}
+
+// Compara argumento com as formas curta e longa de uma opção
+static int ehOpcao(const char *arg, const char *curta, const char *longa) {
+    return (curta && strcmp(arg, curta) == 0) || strcmp(arg, longa) == 0;
+}
+
+// Lê as opções da linha de comando; retorna -1 se houver erro
+static int leArgumentos(int argc, char *argv[], OpcoesLinhaComando *op) {
+    memset(op, 0, sizeof(*op));
+    op->threads = -1;
+    op->verbosidade = -1;
+    op->cabecalho_csv = 1;
+    op->modo_tabela = -1;
+    op->tlb.vias[0] = op->tlb.vias[1] = 1;
+    op->tlb.politica = TLB_LRU;
+    op->tlb.asid = 1;
+    op->latencias.memoria = LATENCIA_MEMORIA_PADRAO;
+    op->latencias.falta = LATENCIA_FALTA_PADRAO;
+    op->latencias.escrita = LATENCIA_ESCRITA_PADRAO;
+    op->latencias.compressao = LATENCIA_COMPRESSAO_PADRAO;
+    op->latencias.descompressao = LATENCIA_DESCOMPRESSAO_PADRAO;
+    op->antecipacao.politica = ANTECIPA_NENHUMA;
+    op->antecipacao.paginas = ANTECIPA_PAGINAS_PADRAO;
+    op->quantum = QUANTUM_PADRAO;
+    op->alocacao.modo = ALOCA_GLOBAL;
+    op->alocacao.janela = ALOCA_JANELA_PADRAO;
+    op->alocacao.limiar_thrashing = ALOCA_LIMIAR_PADRAO;
+    op->janela_serie = ESTAT_JANELA_PADRAO;
+    op->limiar_promocao = GRANDES_LIMIAR_PADRAO;
+    op->comprimida.num_razoes = 1;
+    op->comprimida.razoes[0] = COMPRIMIDA_RAZAO_PADRAO;
+    op->comprimida.acumuladas[0] = 1.0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (posicaoNaLista(arg, opcoes_estruturais) >= 0)
+            op->estruturais++;
+        int ajuste = posicaoNaLista(arg, opcoes_ajustaveis);
+        if (ajuste >= 0)
+            op->ajustadas |= 1u << ajuste;
+        // Opções sem valor
+        if (ehOpcao(arg, "-h", "--ajuda")) {
+            imprimeUso(argv[0]);
+            exit(0);
+        } else if (ehOpcao(arg, "-q", "--silencioso")) {
+            op->verbosidade = VERBOSIDADE_SILENCIOSO;
+            continue;
+        } else if (ehOpcao(arg, NULL, "--sem-cabecalho")) {
+            op->cabecalho_csv = 0;
+            continue;
+        } else if (ehOpcao(arg, "-s", "--varredura")) {
+            op->varredura = 1;
+            continue;
+        } else if (ehOpcao(arg, NULL, "--tlb-sem-asid")) {
+            op->tlb.asid = 0;
+            continue;
+        }
+
+        // Demais opções exigem valor
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Opcao invalida ou sem valor: %s\n", arg);
+            return -1;
+        }
+        const char *valor = argv[++i];
+        if (ehOpcao(arg, "-p", "--pagina")) {
+            op->num_tamanhos_pagina = leLista(valor, leTamanho, op->tamanhos_pagina);
+            if (op->num_tamanhos_pagina < 0) {
+                fprintf(stderr, "Tamanho de pagina invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, "-m", "--memoria")) {
+            op->num_tamanhos_memoria = leListaBytes(valor, op->tamanhos_memoria);
+            if (op->num_tamanhos_memoria < 0) {
+                fprintf(stderr, "Tamanho de memoria invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, "-a", "--algoritmo")) {
+            if (strcmp(valor, "todos") == 0) {
+                // Todos os algoritmos, para comparar lado a lado
+                for (int a = 0; a < NUM_ALGORITMOS; a++)
+                    op->algoritmos[a] = a;
+                op->num_algoritmos = NUM_ALGORITMOS;
+            } else {
+                op->num_algoritmos = leLista(valor, algoritmoPorNome, op->algoritmos);
+            }
+            if (op->num_algoritmos < 0) {
+                fprintf(stderr, "Algoritmo desconhecido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--tabela")) {
+            op->modo_tabela = modoTabelaPorNome(valor);
+            if (op->modo_tabela < 0) {
+                fprintf(stderr, "Tabela de paginas desconhecida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--niveis")) {
+            op->niveis = atoi(valor);
+            if (op->niveis < NIVEIS_MIN || op->niveis > NIVEIS_MAX) {
+                fprintf(stderr, "Numero de niveis invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--tlb") || ehOpcao(arg, NULL, "--tlb2")) {
+            int n = strcmp(arg, "--tlb2") == 0;
+            if (leGeometriaTLB(valor, &op->tlb.conjuntos[n], &op->tlb.vias[n]) != 0) {
+                fprintf(stderr, "Geometria de TLB invalida (use CONJUNTOSxVIAS): %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--tlb-politica")) {
+            op->tlb.politica = politicaTLBPorNome(valor);
+            if (op->tlb.politica < 0) {
+                fprintf(stderr, "Politica de TLB desconhecida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--latencia-memoria") ||
+                   ehOpcao(arg, NULL, "--latencia-falta") ||
+                   ehOpcao(arg, NULL, "--latencia-escrita") ||
+                   ehOpcao(arg, NULL, "--latencia-compressao") ||
+                   ehOpcao(arg, NULL, "--latencia-descompressao")) {
+            double *latencia = strcmp(arg, "--latencia-memoria") == 0 ? &op->latencias.memoria
+                               : strcmp(arg, "--latencia-falta") == 0 ? &op->latencias.falta
+                               : strcmp(arg, "--latencia-escrita") == 0 ? &op->latencias.escrita
+                               : strcmp(arg, "--latencia-compressao") == 0
+                                   ? &op->latencias.compressao
+                                   : &op->latencias.descompressao;
+            if (leLatencia(valor, latencia) != 0) {
+                fprintf(stderr, "Latencia invalida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--preferir-limpas")) {
+            op->janela_limpas = atoi(valor);
+            if (op->janela_limpas < 0) {
+                fprintf(stderr, "Janela invalida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--antecipacao")) {
+            op->antecipacao.politica = politicaAntecipacaoPorNome(valor);
+            if (op->antecipacao.politica < 0) {
+                fprintf(stderr, "Leitura antecipada desconhecida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--antecipacao-paginas")) {
+            op->antecipacao.paginas = atoi(valor);
+            if (op->antecipacao.paginas < 1 || op->antecipacao.paginas > ANTECIPA_PAGINAS_MAX) {
+                fprintf(stderr, "Numero de paginas antecipadas invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--processos")) {
+            // Os nomes ficam no próprio argv, separados no lugar das vírgulas
+            op->num_processos = 0;
+            for (char *item = strtok(argv[i], ","); item; item = strtok(NULL, ",")) {
+                if (op->num_processos == MAX_VALORES_OPCAO) {
+                    fprintf(stderr, "Traces demais em --processos (maximo %d)\n",
+                            MAX_VALORES_OPCAO);
+                    return -1;
+                }
+                op->processos[op->num_processos++] = item;
+            }
+            if (op->num_processos == 0) {
+                fprintf(stderr, "Lista de traces vazia\n");
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--quantum")) {
+            op->quantum = atoi(valor);
+            if (op->quantum < 1) {
+                fprintf(stderr, "Quantum invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--alocacao")) {
+            op->alocacao.modo = modoAlocacaoPorNome(valor);
+            if (op->alocacao.modo < 0) {
+                fprintf(stderr, "Alocacao desconhecida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--janela-alocacao")) {
+            op->alocacao.janela = atoi(valor);
+            if (op->alocacao.janela < 1) {
+                fprintf(stderr, "Janela invalida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--limiar-thrashing")) {
+            char *fim;
+            op->alocacao.limiar_thrashing = strtod(valor, &fim);
+            if (fim == valor || *fim != '\0' || !(op->alocacao.limiar_thrashing > 0.0) ||
+                op->alocacao.limiar_thrashing > 1.0) {
+                fprintf(stderr, "Limiar invalido (use uma fracao entre 0 e 1): %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--paginas-grandes")) {
+            op->pagina_grande = leTamanho(valor);
+            if (op->pagina_grande < 0) {
+                fprintf(stderr, "Tamanho de pagina grande invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--limiar-promocao")) {
+            char *fim;
+            op->limiar_promocao = strtod(valor, &fim);
+            if (fim == valor || *fim != '\0' || !(op->limiar_promocao > 0.0) ||
+                op->limiar_promocao > 1.0) {
+                fprintf(stderr, "Limiar invalido (use uma fracao entre 0 e 1): %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--memoria-comprimida")) {
+            op->comprimida.capacidade = leBytes(valor);
+            if (op->comprimida.capacidade < 0) {
+                fprintf(stderr, "Tamanho de memoria comprimida invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--razao-compressao")) {
+            if (leRazoesCompressao(valor, &op->comprimida) != 0) {
+                fprintf(stderr, "Razoes de compressao invalidas (use R ou R:PESO,R:PESO,...): "
+                                "%s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--estatisticas")) {
+            op->estatisticas = valor;
+        } else if (ehOpcao(arg, NULL, "--janela-serie")) {
+            op->janela_serie = atoi(valor);
+            if (op->janela_serie < 1) {
+                fprintf(stderr, "Janela invalida: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--eventos")) {
+            op->eventos = valor;
+        } else if (ehOpcao(arg, NULL, "--salva-estado")) {
+            op->salva_estado = valor;
+        } else if (ehOpcao(arg, NULL, "--salva-a-cada")) {
+            op->salva_a_cada = strtoll(valor, NULL, 10);
+            if (op->salva_a_cada < 1) {
+                fprintf(stderr, "Intervalo invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, NULL, "--restaura-estado")) {
+            op->restaura_estado = valor;
+        } else if (ehOpcao(arg, "-j", "--paralelo")) {
+            op->threads = atoi(valor);
+            if (op->threads < 0) {
+                fprintf(stderr, "Numero de threads invalido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, "-t", "--trace")) {
+            op->trace = valor;
+        } else if (ehOpcao(arg, "-f", "--formato")) {
+            if (strcmp(valor, "texto") == 0)
+                op->formato = SAIDA_TEXTO;
+            else if (strcmp(valor, "csv") == 0)
+                op->formato = SAIDA_CSV;
+            else if (strcmp(valor, "json") == 0)
+                op->formato = SAIDA_JSON;
+            else {
+                fprintf(stderr, "Formato desconhecido: %s\n", valor);
+                return -1;
+            }
+        } else if (ehOpcao(arg, "-c", "--converte")) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Opcao %s exige origem e destino\n", arg);
+                return -1;
+            }
+            op->converter_origem = valor;
+            op->converter_destino = argv[++i];
+        } else if (ehOpcao(arg, "-v", "--verbosidade")) {
+            op->verbosidade = atoi(valor);
+            if (op->verbosidade < VERBOSIDADE_SILENCIOSO || op->verbosidade > VERBOSIDADE_COMPLETO) {
+                fprintf(stderr, "Verbosidade invalida: %s\n", valor);
+                return -1;
+            }
+        } else {
+            fprintf(stderr, "Opcao desconhecida: %s\n", arg);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Tempo monotônico em segundos
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Exibe o cabeçalho da tabela de resultados
+static void imprimeCabecalhoResultados(const OpcoesLinhaComando *op) {
+    if (op->formato == SAIDA_CSV && op->cabecalho_csv)
+        printf("algoritmo,tamanho_pagina,memoria_fisica,frames,acessos,page_faults,"
+               "taxa_page_faults,segundos,memoria_tabelas,tlb_hits,tlb_misses,"
+               "tlb2_hits,tlb2_misses,escritas_disco,tempo_efetivo_ns,antecipadas,"
+               "antecipadas_uteis,antecipadas_atrasadas,antecipadas_desperdicadas,intervalos,"
+               "intervalos_thrashing,faltas_sem_folga,promocoes,rebaixamentos,"
+               "faltas_sem_bloco,preenchidas,preenchidas_usadas,tlb_hits_grandes,comprimidas,"
+               "rejeitadas,faltas_comprimidas,descomprimidas,devolvidas,devolvidas_gravadas,"
+               "pico_comprimida,tempo_comprimida_ns,tempo_disco_ns\n");
+    else if (op->formato == SAIDA_TEXTO)
+        printf("%-15s %10s %14s %9s %12s %12s %8s %9s %8s %8s %8s\n", "Algoritmo", "Pagina",
+               "Memoria", "Frames", "Acessos", "Faults", "Taxa", "Segundos", "vs FIFO", "vs LRU",
+               "vs OPT");
+}
+
+// Faults do algoritmo de referência com a mesma página e memória; -1 se não foi simulado
+static int64_t faltasDeReferencia(const ConfiguracaoSimulacao *configs, int num_configs,
+                              const ConfiguracaoSimulacao *cfg, int algoritmo) {
+    for (int i = 0; i < num_configs; i++) {
+        if (configs[i].algoritmo == algoritmo && configs[i].status == 0 &&
+            configs[i].tamanho_pagina == cfg->tamanho_pagina &&
+            configs[i].tamanho_memoria_fisica == cfg->tamanho_memoria_fisica)
+            return configs[i].page_faults;
+    }
+    return -1;
+}
+
+// Exibe a redução de faults em relação à referência ("-" se ela não foi simulada)
+static void imprimeReducao(int64_t faults, int64_t faults_referencia) {
+    if (faults_referencia <= 0)
+        printf(" %8s", "-");
+    else
+        printf(" %7.1f%%", 100.0 * (faults_referencia - faults) / faults_referencia);
+}
+
+// Exibe uma linha da tabela de resultados (JSON: um objeto por linha); no texto,
+// compara com FIFO, LRU e OPT de mesma configuração quando estão em configs
+static void imprimeLinhaResultado(const ConfiguracaoSimulacao *cfg, const OpcoesLinhaComando *op,
+                                  const ConfiguracaoSimulacao *configs, int num_configs) {
+    double taxa = cfg->total_acessos ? (double)cfg->page_faults / cfg->total_acessos : 0.0;
+    switch (op->formato) {
+        case SAIDA_CSV:
+            printf("%s,%d,%lld,%d,%lld,%lld,%.6f,%.6f,%lld,%lld,%lld,%lld,%lld,%lld,%.1f,"
+                   "%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,"
+                   "%lld,%lld,%lld,%lld,%lld,%lld,%lld,%.1f,%.1f\n",
+                   nomeAlgoritmo(cfg->algoritmo), cfg->tamanho_pagina,
+                   (long long)cfg->tamanho_memoria_fisica, cfg->num_frames,
+                   (long long)cfg->total_acessos, (long long)cfg->page_faults, taxa,
+                   cfg->segundos, (long long)cfg->memoria_tabelas, (long long)cfg->tlb_hits[0],
+                   (long long)cfg->tlb_misses[0], (long long)cfg->tlb_hits[1],
+                   (long long)cfg->tlb_misses[1], (long long)cfg->escritas_disco,
+                   cfg->tempo_efetivo, (long long)cfg->antecipadas,
+                   (long long)cfg->antecipadas_uteis,
+                   (long long)cfg->antecipadas_atrasadas,
+                   (long long)cfg->antecipadas_desperdicadas, (long long)cfg->intervalos,
+                   (long long)cfg->intervalos_thrashing, (long long)cfg->faltas_sem_folga,
+                   (long long)cfg->promocoes, (long long)cfg->rebaixamentos,
+                   (long long)cfg->faltas_sem_bloco, (long long)cfg->preenchidas,
+                   (long long)cfg->preenchidas_usadas, (long long)cfg->tlb_hits_grandes,
+                   (long long)cfg->comprimidas, (long long)cfg->rejeitadas,
+                   (long long)cfg->faltas_comprimidas, (long long)cfg->descomprimidas,
+                   (long long)cfg->devolvidas, (long long)cfg->devolvidas_gravadas,
+                   (long long)cfg->pico_comprimida, cfg->tempo_comprimida, cfg->tempo_disco);
+            break;
+        case SAIDA_JSON:
+            printf("{\"algoritmo\":\"%s\",\"tamanho_pagina\":%d,\"memoria_fisica\":%lld,"
+                   "\"frames\":%d,\"acessos\":%lld,\"page_faults\":%lld,\"taxa_page_faults\":%.6f,"
+                   "\"segundos\":%.6f,\"memoria_tabelas\":%lld,\"tlb_hits\":%lld,"
+                   "\"tlb_misses\":%lld,\"tlb2_hits\":%lld,\"tlb2_misses\":%lld,"
+                   "\"escritas_disco\":%lld,\"tempo_efetivo_ns\":%.1f,\"antecipadas\":%lld,"
+                   "\"antecipadas_uteis\":%lld,\"antecipadas_atrasadas\":%lld,"
+                   "\"antecipadas_desperdicadas\":%lld,\"intervalos\":%lld,"
+                   "\"intervalos_thrashing\":%lld,\"faltas_sem_folga\":%lld,\"promocoes\":%lld,"
+                   "\"rebaixamentos\":%lld,\"faltas_sem_bloco\":%lld,\"preenchidas\":%lld,"
+                   "\"preenchidas_usadas\":%lld,\"tlb_hits_grandes\":%lld,\"comprimidas\":%lld,"
+                   "\"rejeitadas\":%lld,\"faltas_comprimidas\":%lld,\"descomprimidas\":%lld,"
+                   "\"devolvidas\":%lld,\"devolvidas_gravadas\":%lld,\"pico_comprimida\":%lld,"
+                   "\"tempo_comprimida_ns\":%.1f,\"tempo_disco_ns\":%.1f}\n",
+                   nomeAlgoritmo(cfg->algoritmo), cfg->tamanho_pagina,
+                   (long long)cfg->tamanho_memoria_fisica, cfg->num_frames,
+                   (long long)cfg->total_acessos, (long long)cfg->page_faults, taxa,
+                   cfg->segundos, (long long)cfg->memoria_tabelas, (long long)cfg->tlb_hits[0],
+                   (long long)cfg->tlb_misses[0], (long long)cfg->tlb_hits[1],
+                   (long long)cfg->tlb_misses[1], (long long)cfg->escritas_disco,
+                   cfg->tempo_efetivo, (long long)cfg->antecipadas,
+                   (long long)cfg->antecipadas_uteis, (long long)cfg->antecipadas_atrasadas,
+                   (long long)cfg->antecipadas_desperdicadas, (long long)cfg->intervalos,
+                   (long long)cfg->intervalos_thrashing, (long long)cfg->faltas_sem_folga,
+                   (long long)cfg->promocoes, (long long)cfg->rebaixamentos,
+                   (long long)cfg->faltas_sem_bloco, (long long)cfg->preenchidas,
+                   (long long)cfg->preenchidas_usadas, (long long)cfg->tlb_hits_grandes,
+                   (long long)cfg->comprimidas, (long long)cfg->rejeitadas,
+                   (long long)cfg->faltas_comprimidas, (long long)cfg->descomprimidas,
+                   (long long)cfg->devolvidas, (long long)cfg->devolvidas_gravadas,
+                   (long long)cfg->pico_comprimida, cfg->tempo_comprimida, cfg->tempo_disco);
+            break;
+        default:
+            printf("%-15s %10d %14lld %9d %12lld %12lld %7.2f%% %9.3f", nomeAlgoritmo(cfg->algoritmo),
+                   cfg->tamanho_pagina, (long long)cfg->tamanho_memoria_fisica, cfg->num_frames,
+                   (long long)cfg->total_acessos, (long long)cfg->page_faults, taxa * 100.0, cfg->segundos);
+            imprimeReducao(cfg->page_faults, faltasDeReferencia(configs, num_configs, cfg, ALG_FIFO));
+            imprimeReducao(cfg->page_faults, faltasDeReferencia(configs, num_configs, cfg, ALG_LRU));
+            imprimeReducao(cfg->page_faults, faltasDeReferencia(configs, num_configs, cfg, ALG_OTIMO));
+            printf("\n");
+            break;
+    }
+}
+
+// Decodifica a entrada do modo lote: o trace ou os traces de --processos intercalados
+static int64_t carregaEntrada(const OpcoesLinhaComando *op, AcessoTrace **acessos) {
+    if (op->num_processos > 0)
+        return intercalaTraces(op->processos, op->num_processos, op->quantum, acessos);
+    return carregaTrace(op->trace, acessos);
+}
+
+// Grava as estatísticas detalhadas no arquivo (JSON se o nome termina em .json)
+static int gravaEstatisticas(const Simulador *sim, const char *caminho) {
+    size_t n = strlen(caminho);
+    int json = n >= 5 && strcmp(caminho + n - 5, ".json") == 0;
+    FILE *saida = fopen(caminho, "w");
+    if (!saida) {
+        fprintf(stderr, "Erro ao criar %s\n", caminho);
+        return -1;
+    }
+    int status = escreveEstatisticas(sim, saida, json);
+    if (fclose(saida) != 0 || status != 0) {
+        fprintf(stderr, "Erro ao gravar %s\n", caminho);
+        return -1;
+    }
+    return 0;
+}
+
+// Reproduz a entrada a partir do acesso primeiro (do leitor ou, se ele é NULL, do
+// vetor), gravando o estado a cada --salva-a-cada acessos e ao fim. Retorna os
+// acessos reproduzidos ou -1 em erro
+static int64_t executaComEstado(Simulador *sim, LeitorTrace *leitor, const AcessoTrace *acessos,
+                                int64_t num_acessos, int64_t primeiro,
+                                const OpcoesLinhaComando *op) {
+    int64_t pulados = leitor ? pulaAcessos(leitor, primeiro)
+                             : (primeiro < num_acessos ? primeiro : num_acessos);
+    if (pulados < 0)
+        return -1;
+    if (pulados < primeiro)
+        fprintf(stderr, "Aviso: a entrada acaba antes do acesso %lld do estado restaurado\n",
+                (long long)primeiro);
+
+    if (preparaTraducao(sim, sim->algoritmo) != 0)
+        return -1;
+    int64_t posicao = primeiro, executados = 0;
+    for (;;) {
+        AcessoTrace acesso;
+        if (leitor) {
+            int r = proximoAcesso(leitor, &acesso);
+            if (r < 0)
+                return -1;
+            if (r == 0)
+                break;
+        } else if (posicao < num_acessos) {
+            acesso = acessos[posicao];
+        } else {
+            break;
+        }
+        if (reproduzAcesso(sim, &acesso) != 0)
+            return -1;
+        posicao++;
+        executados++;
+        if (op->salva_a_cada > 0 && executados % op->salva_a_cada == 0 &&
+            salvaInstantaneo(sim, op->salva_estado, posicao) != 0)
+            return -1;
+    }
+    if (op->salva_estado && salvaInstantaneo(sim, op->salva_estado, posicao) != 0)
+        return -1;
+    return executados;
+}
+
+// Reproduz o trace sem interação, a partir do acesso primeiro se o estado foi
+// restaurado; retorna o código de saída do programa
+static int executaLote(Simulador *sim, const OpcoesLinhaComando *op, int64_t primeiro) {
+    double inicio, segundos;
+    int64_t executados;
+    int com_estado = op->salva_estado || op->restaura_estado;
+    if (op->estatisticas && ativaEstatisticas(sim, op->janela_serie) != 0)
+        return 2;
+    if (op->eventos && abreLogEventos(sim, op->eventos) != 0)
+        return 2;
+    if (op->num_processos > 0) {
+        // A intercalação precisa de todos os traces na memória
+        AcessoTrace *acessos;
+        int64_t num_acessos = carregaEntrada(op, &acessos);
+        if (num_acessos < 0)
+            return 2;
+        inicio = agora();
+        executados = com_estado ? executaComEstado(sim, NULL, acessos, num_acessos, primeiro, op)
+                                : executaAcessos(sim, acessos, num_acessos);
+        segundos = agora() - inicio;
+        free(acessos);
+    } else {
+        LeitorTrace leitor;
+        if (abreTrace(&leitor, op->trace) != 0)
+            return 2;
+        inicio = agora();
+        executados = com_estado ? executaComEstado(sim, &leitor, NULL, 0, primeiro, op)
+                                : executaTrace(sim, &leitor);
+        segundos = agora() - inicio;
+        fechaTrace(&leitor);
+    }
+    if (executados < 0)
+        return 2;
+    if (op->eventos && fechaLogEventos(sim) != 0) {
+        fprintf(stderr, "Erro ao gravar o log de eventos %s\n", op->eventos);
+        return 2;
+    }
+    if (op->estatisticas && gravaEstatisticas(sim, op->estatisticas) != 0)
+        return 2;
+    if (sim->verbosidade < VERBOSIDADE_RESUMO)
+        return 0;
+
+    if (op->formato == SAIDA_TEXTO) {
+        imprimeResultados(sim);
+    } else {
+        ConfiguracaoSimulacao cfg = {sim->algoritmo, sim->tamanho_pagina,
+                                     sim->tamanho_memoria_fisica, sim->modo_tabela, sim->niveis,
+                                     sim->tlb.parametros, sim->latencias, sim->janela_limpas,
+                                     sim->antecipacao, sim->alocacao,
+                                     grandesAtivas(sim) ? sim->grandes.fator * sim->tamanho_pagina : 0,
+                                     sim->grandes.limiar, sim->comprimida,
+                                     sim->memoria.num_frames,
+                                     sim->total_acessos, sim->page_faults, sim->escritas_disco,
+                                     tempoEfetivoAcesso(sim), sim->antecipadas,
+                                     sim->antecipadas_uteis, sim->antecipadas_atrasadas,
+                                     sim->antecipadas_desperdicadas, sim->intervalos,
+                                     sim->intervalos_thrashing, sim->faltas_sem_folga,
+                                     sim->promocoes, sim->rebaixamentos, sim->faltas_sem_bloco,
+                                     sim->preenchidas, sim->preenchidas_usadas,
+                                     sim->hits_tlb_grandes, sim->comprimidas, sim->rejeitadas,
+                                     sim->faltas_comprimidas, sim->descomprimidas,
+                                     sim->devolvidas, sim->devolvidas_gravadas,
+                                     sim->pico_comprimida, tempoComprimidaNs(sim),
+                                     tempoDiscoNs(sim), memoriaTabelasPaginas(sim),
+                                     {sim->tlb.nivel[0].hits, sim->tlb.nivel[1].hits},
+                                     {sim->tlb.nivel[0].misses, sim->tlb.nivel[1].misses},
+                                     segundos, 0};
+        imprimeCabecalhoResultados(op);
+        imprimeLinhaResultado(&cfg, op, &cfg, 1);
+    }
+    return 0;
+}
+
+// Se a opção de opcoes_ajustaveis foi dada na linha de comando
+static int ajustou(const OpcoesLinhaComando *op, const char *opcao) {
+    return (op->ajustadas >> posicaoNaLista(opcao, opcoes_ajustaveis)) & 1u;
+}
+
+// Sobre um estado restaurado, aplica só os parâmetros dados na linha de comando
+// (os demais continuam como foram gravados)
+static void aplicaAjustes(Simulador *sim, const OpcoesLinhaComando *op) {
+    if (ajustou(op, "--latencia-memoria"))
+        sim->latencias.memoria = op->latencias.memoria;
+    if (ajustou(op, "--latencia-falta"))
+        sim->latencias.falta = op->latencias.falta;
+    if (ajustou(op, "--latencia-escrita"))
+        sim->latencias.escrita = op->latencias.escrita;
+    if (ajustou(op, "--preferir-limpas"))
+        sim->janela_limpas = op->janela_limpas;
+    if (ajustou(op, "--antecipacao") || ajustou(op, "--antecipacao-paginas")) {
+        ParametrosAntecipacao antecipacao = sim->antecipacao;
+        if (ajustou(op, "--antecipacao"))
+            antecipacao.politica = op->antecipacao.politica;
+        if (ajustou(op, "--antecipacao-paginas"))
+            antecipacao.paginas = op->antecipacao.paginas;
+        configuraAntecipacao(sim, &antecipacao);
+    }
+    if (ajustou(op, "--limiar-thrashing"))
+        sim->alocacao.limiar_thrashing = op->alocacao.limiar_thrashing;
+    if (ajustou(op, "--limiar-promocao"))
+        sim->grandes.limiar = op->limiar_promocao;
+    if (ajustou(op, "--latencia-compressao"))
+        sim->latencias.compressao = op->latencias.compressao;
+    if (ajustou(op, "--latencia-descompressao"))
+        sim->latencias.descompressao = op->latencias.descompressao;
+    if (ajustou(op, "--razao-compressao")) {
+        // Vale para as páginas que entrarem no pool daqui em diante
+        int64_t capacidade = sim->comprimida.capacidade;
+        sim->comprimida = op->comprimida;
+        sim->comprimida.capacidade = capacidade;
+    }
+}
+
+// Simula todas as combinações de algoritmo, página e memória sobre o mesmo
+// trace, decodificado uma única vez e compartilhado entre as threads
+static int executaLoteParalelo(const Simulador *padrao, const OpcoesLinhaComando *op) {
+    AcessoTrace *acessos;
+    int64_t num_acessos = carregaEntrada(op, &acessos);
+    if (num_acessos < 0)
+        return 2;
+
+    // Listas vazias usam o valor padrão
+    int pag_padrao = padrao->tamanho_pagina, alg_padrao = padrao->algoritmo;
+    int64_t mem_padrao = padrao->tamanho_memoria_fisica;
+    const int *paginas = op->num_tamanhos_pagina ? op->tamanhos_pagina : &pag_padrao;
+    const int64_t *memorias = op->num_tamanhos_memoria ? op->tamanhos_memoria : &mem_padrao;
+    const int *algoritmos = op->num_algoritmos ? op->algoritmos : &alg_padrao;
+    int n_pag = op->num_tamanhos_pagina ? op->num_tamanhos_pagina : 1;
+    int n_mem = op->num_tamanhos_memoria ? op->num_tamanhos_memoria : 1;
+    int n_alg = op->num_algoritmos ? op->num_algoritmos : 1;
+
+    int num_configs = n_alg * n_pag * n_mem;
+    ConfiguracaoSimulacao *configs = calloc(num_configs, sizeof(ConfiguracaoSimulacao));
+    if (!configs) {
+        free(acessos);
+        return 2;
+    }
+    int k = 0;
+    for (int a = 0; a < n_alg; a++)
+        for (int p = 0; p < n_pag; p++)
+            for (int m = 0; m < n_mem; m++) {
+                configs[k].algoritmo = algoritmos[a];
+                configs[k].tamanho_pagina = paginas[p];
+                configs[k].tamanho_memoria_fisica = memorias[m];
+                configs[k].modo_tabela = padrao->modo_tabela;
+                configs[k].niveis = padrao->niveis;
+                configs[k].tlb = padrao->tlb.parametros;
+                configs[k].latencias = padrao->latencias;
+                configs[k].janela_limpas = padrao->janela_limpas;
+                configs[k].antecipacao = padrao->antecipacao;
+                configs[k].alocacao = padrao->alocacao;
+                configs[k].pagina_grande = op->pagina_grande;
+                configs[k].limiar_promocao = op->limiar_promocao;
+                configs[k].comprimida = padrao->comprimida;
+                k++;
+            }
+
+    int threads = op->threads > 0 ? op->threads : numeroDeNucleos();
+    int status = executaParalelo(acessos, num_acessos, configs, num_configs, threads) == 0 ? 0 : 2;
+
+    if (padrao->verbosidade >= VERBOSIDADE_RESUMO)
+        imprimeCabecalhoResultados(op);
+    for (int i = 0; i < num_configs; i++) {
+        if (configs[i].status != 0) {
+            fprintf(stderr, "Configuracao invalida: %s, pagina %d, memoria %lld\n",
+                    nomeAlgoritmo(configs[i].algoritmo), configs[i].tamanho_pagina,
+                    (long long)configs[i].tamanho_memoria_fisica);
+            status = 2;
+        } else if (padrao->verbosidade >= VERBOSIDADE_RESUMO) {
+            imprimeLinhaResultado(&configs[i], op, configs, num_configs);
+        }
+    }
+
+    free(configs);
+    free(acessos);
+    return status;
+}
+
+// Calcula e exibe a curva de page faults do LRU para todos os números de frames
+static int executaVarredura(const OpcoesLinhaComando *op, int tamanho_pagina) {
+    LeitorTrace leitor;
+    if (abreTrace(&leitor, op->trace) != 0)
+        return 2;
+    CurvaFaltas curva;
+    int status = calculaCurvaLRU(&leitor, tamanho_pagina, &curva);
+    fechaTrace(&leitor);
+    if (status != 0) {
+        liberaCurva(&curva);
+        return 2;
+    }
+
+    // Além da maior distância de pilha sobram apenas as faltas frias
+    int ultimo = curva.max_distancia > 0 ? curva.max_distancia : 1;
+    int64_t faltas = curva.total_acessos; // Com 0 frames todo acesso é falta
+    if (op->formato == SAIDA_CSV && op->cabecalho_csv)
+        printf("frames,memoria_fisica,page_faults,taxa_page_faults\n");
+    else if (op->formato == SAIDA_JSON)
+        printf("[");
+    else if (op->formato == SAIDA_TEXTO)
+        printf("%10s %14s %14s %10s\n", "Frames", "Memoria", "Page faults", "Taxa");
+    for (int frames = 1; frames <= ultimo; frames++) {
+        if (frames <= curva.max_distancia)
+            faltas -= curva.histograma[frames];
+        double taxa = curva.total_acessos ? (double)faltas / curva.total_acessos : 0.0;
+        long long memoria = (long long)frames * tamanho_pagina;
+        switch (op->formato) {
+            case SAIDA_CSV:
+                printf("%d,%lld,%lld,%.6f\n", frames, memoria, (long long)faltas, taxa);
+                break;
+            case SAIDA_JSON:
+                printf("%s{\"frames\":%d,\"memoria_fisica\":%lld,\"page_faults\":%lld,"
+                       "\"taxa_page_faults\":%.6f}", frames > 1 ? "," : "",
+                       frames, memoria, (long long)faltas, taxa);
+                break;
+            default:
+                printf("%10d %14lld %14lld %9.2f%%\n", frames, memoria, (long long)faltas, taxa * 100.0);
+                break;
+        }
+    }
+    if (op->formato == SAIDA_JSON)
+        printf("]\n");
+
+    liberaCurva(&curva);
+    return 0;
+}
+
+// Laço do menu interativo
+static void menuPrincipal(Simulador *sim) {
+    // Configuração de processo de exemplo (8 páginas)
+    adicionaProcesso(sim, 1, 8);
     
     int escolha;
     do {
-        drawHeader(&sim);
+        drawHeader(sim);
         printf("===== MENU PRINCIPAL =====\n");
         printf("1. Parametros\n");
         printf("2. Executar simulacao\n");
+        printf("3. Executar trace de arquivo\n");
+        printf("4. Converter trace para binario\n");
         printf("0. Sair\n");
         printf("Escolha: ");
-        scanf("%d", &escolha);
+        if (scanf("%d", &escolha) != 1)
+            break;
         
         switch(escolha) {
             case 1:
-                menuParametros(&sim);
+                menuParametros(sim);
                 break;
                 
             case 2: {
-                reinicializarMemoria(&sim);
-                drawHeader(&sim);
+                reinicializarMemoria(sim);
+                drawHeader(sim);
                 printf("===== SIMULACAO =====\n");
                 
                 // Sequência de acesso de teste
@@ -144,27 +1416,172 @@ int main() {
                 
                 // Executa cada acesso
                 for(int i = 0; i < num_acessos; i++) {
-                    printf("\n--- Acesso %d: Virtual=%d ---\n", i+1, acessos[i]);
-                    int fisico = traduzEndereco(&sim, 1, acessos[i]);
-                    printf("Resultado: Virtual=%d -> Fisico=%d\n", acessos[i], fisico);
-                    printf("................................................................\n\n");
+                    if (sim->verbosidade >= VERBOSIDADE_COMPLETO)
+                        printf("\n--- Acesso %d: Virtual=%d ---\n", i+1, acessos[i]);
+                    int64_t fisico = traduzEndereco(sim, 1, acessos[i]);
+                    if (sim->verbosidade >= VERBOSIDADE_COMPLETO) {
+                        printf("Resultado: Virtual=%d -> Fisico=%lld\n", acessos[i], (long long)fisico);
+                        printf("................................................................\n\n");
+                    }
                 }
                 
                 // Exibe resultados finais
-                printf("\n===== RESULTADOS =====\n");
-                printf("Total de acessos: %d\n", sim.total_acessos);
-                printf("Page faults: %d\n", sim.page_faults);
-                printf("Taxa de page faults: %.2f%%\n", 
-                       (sim.page_faults * 100.0) / sim.total_acessos);
+                imprimeResultados(sim);
                 
                 printf("\nPressione ENTER para continuar...");
                 getchar();
                 getchar();
                 break;
             }
+
+            case 3:
+                menuTrace(sim);
+                break;
+
+            case 4:
+                menuConverteTrace(sim);
+                break;
         }
     } while(escolha != 0);
-    
+}
+
+int main(int argc, char *argv[]) {
+    setlocale(LC_ALL, "Portuguese");
+    OpcoesLinhaComando opcoes;
+    if (leArgumentos(argc, argv, &opcoes) != 0) {
+        imprimeUso(argv[0]);
+        return 1;
+    }
+    if (opcoes.converter_origem)
+        return converteTrace(opcoes.converter_origem, opcoes.converter_destino) == 0 ? 0 : 2;
+
+    if (opcoes.varredura) {
+        if (!opcoes.trace) {
+            fprintf(stderr, "--varredura exige --trace\n");
+            return 1;
+        }
+        if (opcoes.salva_estado || opcoes.restaura_estado) {
+            fprintf(stderr, "--varredura nao simula a memoria e nao grava nem restaura estado\n");
+            return 1;
+        }
+        return executaVarredura(&opcoes, opcoes.num_tamanhos_pagina ? opcoes.tamanhos_pagina[0] : 4096);
+    }
+
+    if (opcoes.trace && opcoes.num_processos > 0) {
+        fprintf(stderr, "Use --trace ou --processos, nao os dois\n");
+        return 1;
+    }
+    int modo_lote = opcoes.trace != NULL || opcoes.num_processos > 0;
+    Simulador sim;
+    inicializarSimulador(&sim);
+
+    // Aplica parâmetros da linha de comando
+    int tam_pagina = opcoes.num_tamanhos_pagina ? opcoes.tamanhos_pagina[0] : sim.tamanho_pagina;
+    int64_t tam_memoria = opcoes.num_tamanhos_memoria ? opcoes.tamanhos_memoria[0]
+                                                      : sim.tamanho_memoria_fisica;
+    if (configuraMemoria(&sim, tam_pagina, tam_memoria) != 0) {
+        fprintf(stderr, "Memoria fisica menor que uma pagina\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    if ((opcoes.modo_tabela >= 0 || opcoes.niveis > 0) &&
+        configuraTabela(&sim, opcoes.modo_tabela >= 0 ? opcoes.modo_tabela : sim.modo_tabela,
+                        opcoes.niveis > 0 ? opcoes.niveis : sim.niveis) != 0) {
+        fprintf(stderr, "Sem memoria para as tabelas de paginas\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    if (opcoes.tlb.conjuntos[0] == 0 && opcoes.tlb.conjuntos[1] > 0) {
+        fprintf(stderr, "--tlb2 exige --tlb\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    if (opcoes.tlb.conjuntos[0] > 0 && configuraTLB(&sim.tlb, &opcoes.tlb) != 0) {
+        fprintf(stderr, "TLB grande demais\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    sim.latencias = opcoes.latencias;
+    sim.janela_limpas = opcoes.janela_limpas;
+    configuraAntecipacao(&sim, &opcoes.antecipacao); // Já validada em leArgumentos
+    configuraAlocacao(&sim, &opcoes.alocacao);
+    if (opcoes.pagina_grande > 0) {
+        // Com várias páginas, cada uma precisa dividir a página grande
+        for (int p = 0; p < (opcoes.num_tamanhos_pagina ? opcoes.num_tamanhos_pagina : 1); p++) {
+            int pagina = opcoes.num_tamanhos_pagina ? opcoes.tamanhos_pagina[p] : tam_pagina;
+            if (fatorPaginaGrande(opcoes.pagina_grande, pagina) < 0) {
+                fprintf(stderr, "Pagina grande de %d bytes nao e a pagina de %d vezes uma "
+                                "potencia de 2\n", opcoes.pagina_grande, pagina);
+                liberarSimulador(&sim);
+                return 1;
+            }
+        }
+        ParametrosPaginasGrandes grandes = {fatorPaginaGrande(opcoes.pagina_grande, tam_pagina),
+                                            opcoes.limiar_promocao};
+        configuraPaginasGrandes(&sim, &grandes);
+    }
+    configuraComprimida(&sim, &opcoes.comprimida); // Já validada em leArgumentos
+    int64_t primeiro = 0; // Acessos da entrada já reproduzidos no estado restaurado
+    if (opcoes.restaura_estado) {
+        if (opcoes.estruturais > 0) {
+            fprintf(stderr, "Com --restaura-estado pagina, memoria, algoritmo, tabela, TLB, "
+                            "alocacao e paginas grandes vem do estado gravado\n");
+            liberarSimulador(&sim);
+            return 1;
+        }
+        if (restauraInstantaneo(&sim, opcoes.restaura_estado, &primeiro) != 0) {
+            liberarSimulador(&sim);
+            return 2;
+        }
+        aplicaAjustes(&sim, &opcoes);
+    }
+    if (opcoes.num_algoritmos > 0)
+        sim.algoritmo = opcoes.algoritmos[0];
+    for (int a = 0; a < (opcoes.num_algoritmos ? opcoes.num_algoritmos : 1); a++) {
+        int algoritmo = opcoes.num_algoritmos ? opcoes.algoritmos[a] : sim.algoritmo;
+        if (!alocacaoSuportada(sim.alocacao.modo, algoritmo)) {
+            fprintf(stderr, "Alocacao %s so funciona com FIFO, LRU e os relogios, nao com %s\n",
+                    nomeModoAlocacao(sim.alocacao.modo), nomeAlgoritmo(algoritmo));
+            liberarSimulador(&sim);
+            return 1;
+        }
+    }
+    if (opcoes.verbosidade >= 0)
+        sim.verbosidade = opcoes.verbosidade;
+    else
+        sim.verbosidade = modo_lote ? VERBOSIDADE_RESUMO : VERBOSIDADE_COMPLETO;
+
+    int status = 0;
+    int paralelo = opcoes.threads >= 0 || opcoes.num_tamanhos_pagina > 1 ||
+                   opcoes.num_tamanhos_memoria > 1 || opcoes.num_algoritmos > 1;
+    if (modo_lote && paralelo && (opcoes.estatisticas || opcoes.eventos)) {
+        fprintf(stderr, "--estatisticas e --eventos valem para uma simulacao so\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    if ((opcoes.salva_estado || opcoes.restaura_estado) && (!modo_lote || paralelo)) {
+        fprintf(stderr, "--salva-estado e --restaura-estado valem para uma simulacao so, "
+                        "com --trace ou --processos\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    if (opcoes.salva_a_cada > 0 && !opcoes.salva_estado) {
+        fprintf(stderr, "--salva-a-cada exige --salva-estado\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    if (opcoes.salva_estado && sim.algoritmo == ALG_OTIMO) {
+        fprintf(stderr, "O estado do OPT depende do trace inteiro e nao pode ser gravado\n");
+        liberarSimulador(&sim);
+        return 1;
+    }
+    if (modo_lote && paralelo)
+        status = executaLoteParalelo(&sim, &opcoes);
+    else if (modo_lote)
+        status = executaLote(&sim, &opcoes, primeiro);
+    else
+        menuPrincipal(&sim);
+
     liberarSimulador(&sim);
-    return 0;
-}
\ No newline at end of file
+    return status;
+}
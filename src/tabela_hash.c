@@ -0,0 +1,139 @@
+#include "tabela_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Espalha os bits da chave (finalizador do splitmix64)
+static uint64_t espalha(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Aloca os vetores com a capacidade pedida (potência de 2)
+static int alocaPosicoes(MapaHash *mapa, int capacidade) {
+    mapa->chaves = malloc(capacidade * sizeof(uint64_t));
+    mapa->valores = malloc(capacidade * sizeof(int64_t));
+    mapa->ocupado = calloc(capacidade, 1);
+    if (!mapa->chaves || !mapa->valores || !mapa->ocupado) {
+        free(mapa->chaves);
+        free(mapa->valores);
+        free(mapa->ocupado);
+        return -1;
+    }
+    mapa->capacidade = capacidade;
+    mapa->tamanho = 0;
+    return 0;
+}
+
+// Dobra a capacidade e reinsere todas as chaves
+static int redimensiona(MapaHash *mapa) {
+    MapaHash antigo = *mapa;
+    if (alocaPosicoes(mapa, antigo.capacidade * 2) != 0) {
+        *mapa = antigo;
+        return -1;
+    }
+    for (int i = 0; i < antigo.capacidade; i++) {
+        if (antigo.ocupado[i])
+            mapaInsere(mapa, antigo.chaves[i], antigo.valores[i]);
+    }
+    mapaLibera(&antigo);
+    return 0;
+}
+
+// Inicializa mapa vazio
+int mapaInicializa(MapaHash *mapa, int capacidade_inicial) {
+    int capacidade = 16;
+    while (capacidade < capacidade_inicial)
+        capacidade *= 2;
+    return alocaPosicoes(mapa, capacidade);
+}
+
+// Libera os vetores do mapa
+void mapaLibera(MapaHash *mapa) {
+    free(mapa->chaves);
+    free(mapa->valores);
+    free(mapa->ocupado);
+    mapa->chaves = NULL;
+    mapa->valores = NULL;
+    mapa->ocupado = NULL;
+    mapa->capacidade = 0;
+    mapa->tamanho = 0;
+}
+
+// Remove todas as chaves mantendo a capacidade
+void mapaLimpa(MapaHash *mapa) {
+    memset(mapa->ocupado, 0, mapa->capacidade);
+    mapa->tamanho = 0;
+}
+
+// Busca chave; retorna 1 e preenche valor se encontrada
+int mapaBusca(const MapaHash *mapa, uint64_t chave, int64_t *valor) {
+    int mascara = mapa->capacidade - 1;
+    int i = (int)(espalha(chave) & mascara);
+    while (mapa->ocupado[i]) {
+        if (mapa->chaves[i] == chave) {
+            if (valor)
+                *valor = mapa->valores[i];
+            return 1;
+        }
+        i = (i + 1) & mascara;
+    }
+    return 0;
+}
+
+// Insere ou atualiza chave; retorna -1 se faltar memória
+int mapaInsere(MapaHash *mapa, uint64_t chave, int64_t valor) {
+    // Mantém fator de carga abaixo de 1/2
+    if ((mapa->tamanho + 1) * 2 > mapa->capacidade) {
+        if (redimensiona(mapa) != 0)
+            return -1;
+    }
+    int mascara = mapa->capacidade - 1;
+    int i = (int)(espalha(chave) & mascara);
+    while (mapa->ocupado[i]) {
+        if (mapa->chaves[i] == chave) {
+            mapa->valores[i] = valor;
+            return 0;
+        }
+        i = (i + 1) & mascara;
+    }
+    mapa->ocupado[i] = 1;
+    mapa->chaves[i] = chave;
+    mapa->valores[i] = valor;
+    mapa->tamanho++;
+    return 0;
+}
+
+// Remove chave; retorna 1 se estava presente
+int mapaRemove(MapaHash *mapa, uint64_t chave) {
+    int mascara = mapa->capacidade - 1;
+    int i = (int)(espalha(chave) & mascara);
+    while (mapa->ocupado[i] && mapa->chaves[i] != chave)
+        i = (i + 1) & mascara;
+    if (!mapa->ocupado[i])
+        return 0;
+
+    // Desloca para trás as chaves seguintes do mesmo agrupamento
+    // (dispensa marcadores de remoção)
+    int j = i;
+    for (;;) {
+        j = (j + 1) & mascara;
+        if (!mapa->ocupado[j])
+            break;
+        int ideal = (int)(espalha(mapa->chaves[j]) & mascara);
+        // Move j para i se a posição ideal de j não está entre (i, j]
+        int entre = (i <= j) ? (ideal > i && ideal <= j)
+                             : (ideal > i || ideal <= j);
+        if (!entre) {
+            mapa->chaves[i] = mapa->chaves[j];
+            mapa->valores[i] = mapa->valores[j];
+            i = j;
+        }
+    }
+    mapa->ocupado[i] = 0;
+    mapa->tamanho--;
+    return 1;
+}
@@ -0,0 +1,23 @@
+#ifndef TABELA_HASH_H
+#define TABELA_HASH_H
+
+#include <stdint.h>
+
+// Tabela hash de endereçamento aberto (sondagem linear) de chave inteira
+typedef struct
+{
+    uint64_t *chaves;        // Chave armazenada em cada posição
+    int64_t *valores;        // Valor associado a cada chave
+    unsigned char *ocupado;  // 1 se a posição contém uma chave
+    int capacidade;          // Número de posições (sempre potência de 2)
+    int tamanho;             // Número de chaves armazenadas
+} MapaHash;
+
+int mapaInicializa(MapaHash *mapa, int capacidade_inicial);
+void mapaLibera(MapaHash *mapa);
+void mapaLimpa(MapaHash *mapa);
+int mapaBusca(const MapaHash *mapa, uint64_t chave, int64_t *valor);
+int mapaInsere(MapaHash *mapa, uint64_t chave, int64_t valor);
+int mapaRemove(MapaHash *mapa, uint64_t chave);
+
+#endif
@@ -0,0 +1,217 @@
+#include "tabela_paginas.h"
+#include "algoritmos.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Nomes dos modos, na ordem dos valores TABELA_*
+static const char *nomes_modos[NUM_MODOS_TABELA] = {"linear", "multinivel", "invertida"};
+
+// Retorna o nome do modo da tabela de páginas
+const char *nomeModoTabela(int modo) {
+    if (modo < 0 || modo >= NUM_MODOS_TABELA)
+        return "?";
+    return nomes_modos[modo];
+}
+
+// Converte nome ou número do modo no valor TABELA_*; -1 se inválido
+int modoTabelaPorNome(const char *nome) {
+    return indicePorNome(nome, nomes_modos, NUM_MODOS_TABELA);
+}
+
+// Divide os bits do maior número de página igualmente entre os níveis
+void recalculaNiveis(Simulador *sim) {
+    sim->bits_nivel = (sim->bits_pagina + sim->niveis - 1) / sim->niveis;
+}
+
+// Libera a subárvore de um nó (o último nível guarda as entradas)
+static void liberaNo(const Simulador *sim, void *no, int nivel) {
+    if (!no)
+        return;
+    if (nivel < sim->niveis - 1) {
+        void **filhos = no;
+        for (int i = 0; i < (1 << sim->bits_nivel); i++)
+            liberaNo(sim, filhos[i], nivel + 1);
+    }
+    free(no);
+}
+
+// Desce a árvore até a entrada da página, alocando os níveis que faltam; NULL sem memória
+static Pagina *entradaMultinivel(const Simulador *sim, Processo *proc, int64_t num_pag) {
+    int bits = sim->bits_nivel;
+    uint64_t mascara = ((uint64_t)1 << bits) - 1;
+    void **no = &proc->raiz;
+    for (int nivel = 0;; nivel++) {
+        int folha = nivel == sim->niveis - 1;
+        if (!*no) {
+            size_t bytes = ((size_t)1 << bits) * (folha ? sizeof(Pagina) : sizeof(void *));
+            if (!(*no = calloc(1, bytes)))
+                return NULL;
+            proc->bytes_tabela += bytes;
+        }
+        size_t indice = (size_t)(((uint64_t)num_pag >> (bits * (sim->niveis - 1 - nivel))) & mascara);
+        if (folha)
+            return &((Pagina *)*no)[indice];
+        no = &((void **)*no)[indice];
+    }
+}
+
+// Visita as folhas abaixo do nó; prefixo é o índice do nó entre os do seu nível
+static int percorreNo(const Simulador *sim, void *no, int nivel, int64_t prefixo,
+                      VisitaFolha visita, void *contexto) {
+    if (!no)
+        return 0;
+    if (nivel == sim->niveis - 1)
+        return visita(contexto, prefixo << sim->bits_nivel, no);
+    void **filhos = no;
+    for (int i = 0; i < (1 << sim->bits_nivel); i++) {
+        if (percorreNo(sim, filhos[i], nivel + 1, (prefixo << sim->bits_nivel) | i, visita,
+                       contexto) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+// Chama visita para cada folha alocada da tabela multinível, com a primeira página
+// que ela cobre e as suas 2^bits_nivel entradas; para no primeiro retorno diferente de 0
+int percorreFolhas(const Simulador *sim, const Processo *proc, VisitaFolha visita, void *contexto) {
+    return percorreNo(sim, proc->raiz, 0, 0, visita, contexto);
+}
+
+// Aloca a tabela invertida no primeiro uso
+static int preparaInvertida(MemoriaFisica *mem) {
+    if (mem->entradas_invertidas)
+        return 0;
+    mem->entradas_invertidas = calloc(mem->num_frames, sizeof(Pagina));
+    // Com o dobro de posições dos frames o hash nunca precisa crescer
+    if (!mem->entradas_invertidas ||
+        mapaInicializa(&mem->hash_invertida, 2 * mem->num_frames + 2) != 0) {
+        liberaInvertida(mem);
+        return -1;
+    }
+    return 0;
+}
+
+// Esvazia a tabela invertida
+void reiniciaInvertida(MemoriaFisica *mem) {
+    if (!mem->entradas_invertidas)
+        return;
+    memset(mem->entradas_invertidas, 0, mem->num_frames * sizeof(Pagina));
+    mapaLimpa(&mem->hash_invertida);
+}
+
+// Libera a tabela invertida
+void liberaInvertida(MemoriaFisica *mem) {
+    free(mem->entradas_invertidas);
+    mem->entradas_invertidas = NULL;
+    mapaLibera(&mem->hash_invertida);
+}
+
+// Cria a tabela vazia do processo (só a linear é alocada antecipadamente)
+int criaTabela(Simulador *sim, Processo *proc) {
+    proc->tabela_paginas = NULL;
+    proc->raiz = NULL;
+    proc->bytes_tabela = 0;
+    if (sim->modo_tabela != TABELA_LINEAR)
+        return 0;
+    proc->tabela_paginas = calloc((size_t)proc->num_paginas, sizeof(Pagina));
+    return proc->tabela_paginas ? 0 : -1;
+}
+
+// Marca todas as páginas do processo como ausentes
+void limpaTabela(Simulador *sim, Processo *proc) {
+    if (sim->modo_tabela == TABELA_LINEAR) {
+        memset(proc->tabela_paginas, 0, (size_t)proc->num_paginas * sizeof(Pagina));
+    } else if (sim->modo_tabela == TABELA_MULTINIVEL) {
+        // Devolve os níveis: a memória volta a acompanhar só as páginas tocadas
+        liberaNo(sim, proc->raiz, 0);
+        proc->raiz = NULL;
+        proc->bytes_tabela = 0;
+    }
+}
+
+// Libera a tabela do processo
+void liberaTabela(Simulador *sim, Processo *proc) {
+    free(proc->tabela_paginas);
+    liberaNo(sim, proc->raiz, 0);
+    proc->tabela_paginas = NULL;
+    proc->raiz = NULL;
+    proc->bytes_tabela = 0;
+}
+
+// Troca a organização das tabelas; a memória é esvaziada e as tabelas recriadas
+int configuraTabela(Simulador *sim, int modo, int niveis) {
+    if (modo < 0 || modo >= NUM_MODOS_TABELA || niveis < NIVEIS_MIN || niveis > NIVEIS_MAX)
+        return -1;
+    reinicializarMemoria(sim);
+    for (int i = 0; i < sim->num_processos; i++)
+        liberaTabela(sim, &sim->processos[i]);
+    if (modo != TABELA_INVERTIDA)
+        liberaInvertida(&sim->memoria);
+
+    sim->modo_tabela = modo;
+    sim->niveis = niveis;
+    recalculaNiveis(sim);
+    int status = 0;
+    for (int i = 0; i < sim->num_processos; i++) {
+        if (criaTabela(sim, &sim->processos[i]) != 0)
+            status = -1;
+    }
+    return status;
+}
+
+// Localiza a entrada da página em *entrada. Na tabela invertida a página não
+// residente não tem entrada (NULL). Retorna -1 se faltou memória para a tabela
+int buscaEntrada(Simulador *sim, Processo *proc, int64_t num_pag, Pagina **entrada) {
+    MemoriaFisica *mem = &sim->memoria;
+    int64_t frame;
+    switch (sim->modo_tabela) {
+        case TABELA_MULTINIVEL:
+            *entrada = entradaMultinivel(sim, proc, num_pag);
+            return *entrada ? 0 : -1;
+        case TABELA_INVERTIDA:
+            if (preparaInvertida(mem) != 0)
+                return -1;
+            if (mapaBusca(&mem->hash_invertida, chavePagina(sim, proc->pid, num_pag), &frame))
+                *entrada = &mem->entradas_invertidas[frame];
+            else
+                *entrada = NULL;
+            return 0;
+        default:
+            *entrada = &proc->tabela_paginas[num_pag];
+            return 0;
+    }
+}
+
+// Entrada em que a página que faltou é registrada ao entrar no frame
+Pagina *entradaDeCarga(Simulador *sim, int pid, int64_t num_pag, Pagina *entrada, int frame) {
+    if (sim->modo_tabela != TABELA_INVERTIDA)
+        return entrada;
+    // O hash foi dimensionado para todos os frames, então a inserção não aloca
+    mapaInsere(&sim->memoria.hash_invertida, chavePagina(sim, pid, num_pag), frame);
+    return &sim->memoria.entradas_invertidas[frame];
+}
+
+// Tira do hash da tabela invertida a página que está deixando o frame
+void esqueceEntrada(Simulador *sim, int frame) {
+    const EntradaFrame *ef = &sim->memoria.frames[frame];
+    if (sim->modo_tabela == TABELA_INVERTIDA && ef->pid != -1)
+        mapaRemove(&sim->memoria.hash_invertida, chavePagina(sim, ef->pid, ef->pagina));
+}
+
+// Bytes ocupados pelas tabelas de páginas (e pela tabela invertida, se em uso)
+int64_t memoriaTabelasPaginas(const Simulador *sim) {
+    int64_t total = 0;
+    for (int i = 0; i < sim->num_processos; i++) {
+        const Processo *proc = &sim->processos[i];
+        if (sim->modo_tabela == TABELA_LINEAR)
+            total += (long long)proc->num_paginas * sizeof(Pagina);
+        else
+            total += proc->bytes_tabela;
+    }
+    const MemoriaFisica *mem = &sim->memoria;
+    if (sim->modo_tabela == TABELA_INVERTIDA && mem->entradas_invertidas)
+        total += (long long)mem->num_frames * sizeof(Pagina) +
+                 (long long)mem->hash_invertida.capacidade *
+                     (sizeof(uint64_t) + sizeof(int64_t) + sizeof(unsigned char));
+    return total;
+}
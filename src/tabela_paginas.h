@@ -0,0 +1,25 @@
+#ifndef TABELA_PAGINAS_H
+#define TABELA_PAGINAS_H
+
+#include "estruturas.h"
+
+// Recebe a primeira página coberta por uma folha da tabela multinível e as entradas dela
+typedef int (*VisitaFolha)(void *contexto, int64_t primeira, const Pagina *folha);
+
+// Tabelas de páginas: linear, multinível sob demanda ou invertida com hash
+const char *nomeModoTabela(int modo);
+int modoTabelaPorNome(const char *nome);
+int configuraTabela(Simulador *sim, int modo, int niveis);
+void recalculaNiveis(Simulador *sim);
+int criaTabela(Simulador *sim, Processo *proc);
+void limpaTabela(Simulador *sim, Processo *proc);
+void liberaTabela(Simulador *sim, Processo *proc);
+int buscaEntrada(Simulador *sim, Processo *proc, int64_t num_pag, Pagina **entrada);
+Pagina *entradaDeCarga(Simulador *sim, int pid, int64_t num_pag, Pagina *entrada, int frame);
+void esqueceEntrada(Simulador *sim, int frame);
+void reiniciaInvertida(MemoriaFisica *mem);
+void liberaInvertida(MemoriaFisica *mem);
+int percorreFolhas(const Simulador *sim, const Processo *proc, VisitaFolha visita, void *contexto);
+int64_t memoriaTabelasPaginas(const Simulador *sim);
+
+#endif
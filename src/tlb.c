@@ -0,0 +1,209 @@
+#include "tlb.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Maior número de entradas de um nível
+#define MAX_ENTRADAS_TLB (1 << 24)
+
+// Nomes das políticas, na ordem dos valores TLB_*
+static const char *nomes_politicas[NUM_POLITICAS_TLB] = {"lru", "fifo", "aleatoria"};
+
+// Retorna o nome da política de substituição da TLB
+const char *nomePoliticaTLB(int politica) {
+    if (politica < 0 || politica >= NUM_POLITICAS_TLB)
+        return "?";
+    return nomes_politicas[politica];
+}
+
+// Converte o nome da política no valor TLB_*; -1 se inválido
+int politicaTLBPorNome(const char *nome) {
+    for (int i = 0; i < NUM_POLITICAS_TLB; i++) {
+        if (strcmp(nomes_politicas[i], nome) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Primeira entrada do conjunto da chave no nível n (índice = bits baixos da página)
+static EntradaTLB *conjuntoTLB(const TLB *tlb, int n, uint64_t chave) {
+    size_t conjunto = (size_t)(chave & (uint64_t)(tlb->parametros.conjuntos[n] - 1));
+    return &tlb->nivel[n].entradas[(size_t)conjunto * tlb->parametros.vias[n]];
+}
+
+// Gerador xorshift da política aleatória (determinístico entre execuções)
+static uint32_t sorteiaTLB(TLB *tlb) {
+    uint32_t x = tlb->semente;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return tlb->semente = x;
+}
+
+// Invalida todas as entradas dos dois níveis
+static void esvaziaTLB(TLB *tlb) {
+    for (int n = 0; n < 2; n++) {
+        long long total = (long long)tlb->parametros.conjuntos[n] * tlb->parametros.vias[n];
+        for (long long i = 0; i < total; i++)
+            tlb->nivel[n].entradas[i].frame = -1;
+    }
+}
+
+// Procura a tradução no nível n; retorna o frame ou -1
+static int buscaNivel(TLB *tlb, int n, uint64_t chave, int grande) {
+    EntradaTLB *conjunto = conjuntoTLB(tlb, n, chave);
+    for (int v = 0; v < tlb->parametros.vias[n]; v++) {
+        if (conjunto[v].frame >= 0 && conjunto[v].chave == chave && conjunto[v].grande == grande) {
+            if (tlb->parametros.politica == TLB_LRU)
+                conjunto[v].idade = tlb->relogio;
+            return conjunto[v].frame;
+        }
+    }
+    return -1;
+}
+
+// Grava a tradução no nível n, em uma via inválida ou na vítima da política
+static void insereNivel(TLB *tlb, int n, uint64_t chave, int frame, int grande) {
+    EntradaTLB *conjunto = conjuntoTLB(tlb, n, chave);
+    int vias = tlb->parametros.vias[n];
+    int alvo = -1;
+    for (int v = 0; v < vias && alvo < 0; v++) {
+        if (conjunto[v].frame < 0)
+            alvo = v;
+    }
+    if (alvo < 0 && tlb->parametros.politica == TLB_ALEATORIA) {
+        alvo = (int)(sorteiaTLB(tlb) % (uint32_t)vias);
+    } else if (alvo < 0) {
+        // LRU e FIFO: menor idade (último uso ou inserção)
+        alvo = 0;
+        for (int v = 1; v < vias; v++) {
+            if (conjunto[v].idade < conjunto[alvo].idade)
+                alvo = v;
+        }
+    }
+    conjunto[alvo].chave = chave;
+    conjunto[alvo].frame = frame;
+    conjunto[alvo].grande = grande;
+    conjunto[alvo].idade = tlb->relogio;
+}
+
+// Troca a geometria e a política; conjuntos[0] = 0 desliga a TLB. Retorna -1 se
+// os parâmetros forem inválidos ou faltar memória (a TLB anterior é mantida)
+int configuraTLB(TLB *tlb, const ParametrosTLB *parametros) {
+    const ParametrosTLB *p = parametros;
+    if (p->politica < 0 || p->politica >= NUM_POLITICAS_TLB)
+        return -1;
+    if (p->conjuntos[0] == 0 && p->conjuntos[1] != 0)
+        return -1; // L2 sem L1
+    EntradaTLB *novas[2] = {NULL, NULL};
+    for (int n = 0; n < 2; n++) {
+        if (p->conjuntos[n] == 0)
+            continue;
+        // Conjuntos em potência de 2: o índice sai dos bits baixos da página
+        if (p->conjuntos[n] < 0 || (p->conjuntos[n] & (p->conjuntos[n] - 1)) || p->vias[n] < 1 ||
+            (long long)p->conjuntos[n] * p->vias[n] > MAX_ENTRADAS_TLB ||
+            !(novas[n] = malloc((size_t)p->conjuntos[n] * p->vias[n] * sizeof(EntradaTLB)))) {
+            free(novas[0]);
+            return -1;
+        }
+    }
+
+    liberaTLB(tlb);
+    tlb->parametros = *p;
+    for (int n = 0; n < 2; n++) {
+        tlb->nivel[n].entradas = novas[n];
+        if (!novas[n])
+            tlb->parametros.conjuntos[n] = tlb->parametros.vias[n] = 0;
+    }
+    reiniciaTLB(tlb);
+    return 0;
+}
+
+// Esvazia a TLB e zera as estatísticas
+void reiniciaTLB(TLB *tlb) {
+    esvaziaTLB(tlb);
+    for (int n = 0; n < 2; n++) {
+        tlb->nivel[n].hits = 0;
+        tlb->nivel[n].misses = 0;
+    }
+    tlb->relogio = 0;
+    tlb->semente = 2463534242u;
+    tlb->pid_atual = -1;
+    tlb->esvaziamentos = 0;
+}
+
+// Libera as entradas (a TLB fica desligada)
+void liberaTLB(TLB *tlb) {
+    for (int n = 0; n < 2; n++) {
+        free(tlb->nivel[n].entradas);
+        tlb->nivel[n].entradas = NULL;
+        tlb->parametros.conjuntos[n] = 0;
+    }
+}
+
+// Procura a chave (pid, página) no L1 e depois no L2 (um hit no L2 sobe para o L1);
+// com grande, a chave é (pid, região) de uma página grande. Retorna o frame ou -1
+int consultaTLB(TLB *tlb, int pid, uint64_t chave, int grande) {
+    if (tlb->parametros.conjuntos[0] == 0)
+        return -1;
+    // Sem ASID as entradas de outro processo não valem: troca de contexto esvazia
+    if (!tlb->parametros.asid && pid != tlb->pid_atual) {
+        if (tlb->pid_atual != -1) {
+            esvaziaTLB(tlb);
+            tlb->esvaziamentos++;
+        }
+        tlb->pid_atual = pid;
+    }
+    tlb->relogio++;
+
+    int frame = buscaNivel(tlb, 0, chave, grande);
+    if (frame >= 0) {
+        tlb->nivel[0].hits++;
+        return frame;
+    }
+    tlb->nivel[0].misses++;
+    if (tlb->parametros.conjuntos[1] == 0)
+        return -1;
+
+    frame = buscaNivel(tlb, 1, chave, grande);
+    if (frame < 0) {
+        tlb->nivel[1].misses++;
+        return -1;
+    }
+    tlb->nivel[1].hits++;
+    insereNivel(tlb, 0, chave, frame, grande);
+    return frame;
+}
+
+// Registra a tradução obtida na tabela de páginas nos dois níveis
+void insereTLB(TLB *tlb, uint64_t chave, int frame, int grande) {
+    for (int n = 0; n < 2; n++) {
+        if (tlb->parametros.conjuntos[n] > 0)
+            insereNivel(tlb, n, chave, frame, grande);
+    }
+}
+
+// Invalida a tradução da página que saiu da memória (ou da página grande desfeita)
+void invalidaTLB(TLB *tlb, uint64_t chave, int grande) {
+    for (int n = 0; n < 2; n++) {
+        if (tlb->parametros.conjuntos[n] == 0)
+            continue;
+        EntradaTLB *conjunto = conjuntoTLB(tlb, n, chave);
+        for (int v = 0; v < tlb->parametros.vias[n]; v++) {
+            if (conjunto[v].frame >= 0 && conjunto[v].chave == chave &&
+                conjunto[v].grande == grande)
+                conjunto[v].frame = -1;
+        }
+    }
+}
+
+// Alcance do nível n em páginas base: entradas válidas, as grandes valendo fator páginas
+int64_t alcanceTLB(const TLB *tlb, int n, int fator) {
+    int64_t paginas = 0;
+    long long total = (long long)tlb->parametros.conjuntos[n] * tlb->parametros.vias[n];
+    for (long long i = 0; i < total; i++) {
+        const EntradaTLB *e = &tlb->nivel[n].entradas[i];
+        if (e->frame >= 0)
+            paginas += e->grande ? fator : 1;
+    }
+    return paginas;
+}
@@ -0,0 +1,17 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include "estruturas.h"
+
+// TLB associativa por conjuntos (L1 e L2 opcional) na frente da tabela de páginas
+const char *nomePoliticaTLB(int politica);
+int politicaTLBPorNome(const char *nome);
+int configuraTLB(TLB *tlb, const ParametrosTLB *parametros);
+void reiniciaTLB(TLB *tlb);
+void liberaTLB(TLB *tlb);
+int consultaTLB(TLB *tlb, int pid, uint64_t chave, int grande);
+void insereTLB(TLB *tlb, uint64_t chave, int frame, int grande);
+void invalidaTLB(TLB *tlb, uint64_t chave, int grande);
+int64_t alcanceTLB(const TLB *tlb, int n, int fator);
+
+#endif
@@ -0,0 +1,382 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "trace.h"
+#include "algoritmos.h"
+#include "otimo.h"
+#include "instrumentacao.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Maior endereço virtual aceito nos traces
+#define MAX_ENDERECO ((INT64_C(1) << BITS_ENDERECO_VIRTUAL) - 1)
+
+// Tamanho da janela mapeada por vez (memória constante para traces grandes)
+#ifndef TRACE_JANELA
+#define TRACE_JANELA (64ULL * 1024 * 1024)
+#endif
+
+#ifndef _WIN32
+// Mapeia a janela do arquivo que contém a posição atual
+static int mapeiaJanela(LeitorTrace *leitor) {
+    if (leitor->janela)
+        munmap((void *)leitor->janela, leitor->tamanho_janela);
+    leitor->janela = NULL;
+
+    uint64_t tam_pag = (uint64_t)sysconf(_SC_PAGESIZE);
+    uint64_t inicio = leitor->posicao - (leitor->posicao % tam_pag);
+    uint64_t tamanho = leitor->tamanho_arquivo - inicio;
+    if (tamanho > TRACE_JANELA)
+        tamanho = TRACE_JANELA;
+
+    void *mapa = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, leitor->fd, (off_t)inicio);
+    if (mapa == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    posix_madvise(mapa, tamanho, POSIX_MADV_SEQUENTIAL);
+    leitor->janela = mapa;
+    leitor->inicio_janela = inicio;
+    leitor->tamanho_janela = tamanho;
+    return 0;
+}
+#endif
+
+// Registro cortado no fim do arquivo (gravação interrompida ou cópia incompleta)
+static int registroIncompleto(void) {
+    fprintf(stderr, "Trace termina no meio de um registro\n");
+    return -1;
+}
+
+// Lê o próximo registro do formato binário
+static int proximoBinario(LeitorTrace *leitor, AcessoTrace *acesso) {
+    RegistroTrace reg;
+#ifndef _WIN32
+    if (leitor->fd >= 0) {
+        if (leitor->posicao + sizeof(reg) > leitor->tamanho_arquivo)
+            return leitor->posicao < leitor->tamanho_arquivo ? registroIncompleto() : 0;
+        if (!leitor->janela ||
+            leitor->posicao + sizeof(reg) > leitor->inicio_janela + leitor->tamanho_janela) {
+            if (mapeiaJanela(leitor) != 0)
+                return -1;
+        }
+        memcpy(&reg, leitor->janela + (leitor->posicao - leitor->inicio_janela), sizeof(reg));
+        leitor->posicao += sizeof(reg);
+    } else
+#endif
+    {
+        size_t lidos = fread(&reg, 1, sizeof(reg), leitor->arquivo);
+        if (lidos != sizeof(reg))
+            return (lidos > 0) ? registroIncompleto() : (ferror(leitor->arquivo) ? -1 : 0);
+    }
+
+    if (reg.endereco > (uint64_t)MAX_ENDERECO || reg.pid > INT_MAX) {
+        fprintf(stderr, "Registro de trace fora do intervalo suportado\n");
+        return -1;
+    }
+    acesso->pid = (int)reg.pid;
+    acesso->op = (reg.op == 'W' || reg.op == 1) ? 'W' : 'R';
+    acesso->endereco = (int64_t)reg.endereco;
+    return 1;
+}
+
+// Lê a próxima linha válida do formato texto ("pid op endereco")
+static int proximoTexto(LeitorTrace *leitor, AcessoTrace *acesso) {
+    char linha[256];
+    int invalida = 0;
+    while (fgets(linha, sizeof(linha), leitor->arquivo)) {
+        leitor->linha++;
+        char *p = linha;
+        while (isspace((unsigned char)*p))
+            p++;
+        // Ignora linhas vazias e comentários
+        if (*p == '\0' || *p == '#')
+            continue;
+
+        char *fim;
+        long pid = strtol(p, &fim, 10);
+        if (fim == p || pid < 0 || pid > INT_MAX) {
+            invalida = 1;
+            break;
+        }
+        p = fim;
+        while (isspace((unsigned char)*p))
+            p++;
+        char op = (char)toupper((unsigned char)*p);
+        if (op != 'R' && op != 'W') {
+            invalida = 1;
+            break;
+        }
+        p++;
+        long long endereco = strtoll(p, &fim, 0);
+        if (fim == p || endereco < 0 || endereco > MAX_ENDERECO) {
+            invalida = 1;
+            break;
+        }
+
+        acesso->pid = (int)pid;
+        acesso->op = op;
+        acesso->endereco = endereco;
+        return 1;
+    }
+    if (invalida || ferror(leitor->arquivo)) {
+        fprintf(stderr, "Linha %ld do trace invalida (esperado: pid R|W endereco)\n",
+                leitor->linha);
+        return -1;
+    }
+    return 0;
+}
+
+// Abre trace detectando o formato pelo cabeçalho ("-" = texto na entrada padrão)
+int abreTrace(LeitorTrace *leitor, const char *caminho) {
+    memset(leitor, 0, sizeof(*leitor));
+    leitor->fd = -1;
+
+    if (strcmp(caminho, "-") == 0) {
+        leitor->arquivo = stdin;
+        leitor->formato = TRACE_TEXTO;
+        return 0;
+    }
+
+    leitor->arquivo = fopen(caminho, "rb");
+    if (!leitor->arquivo) {
+        perror(caminho);
+        return -1;
+    }
+
+    CabecalhoTrace cab;
+    if (fread(&cab, sizeof(cab), 1, leitor->arquivo) == 1 &&
+        memcmp(cab.magico, TRACE_MAGICO, 4) == 0) {
+        if (cab.versao != TRACE_VERSAO) {
+            fprintf(stderr, "%s: versao de trace %u nao suportada\n", caminho, cab.versao);
+            fechaTrace(leitor);
+            return -1;
+        }
+        leitor->formato = TRACE_BINARIO;
+        leitor->posicao = sizeof(cab);
+#ifndef _WIN32
+        // Arquivos regulares são lidos por janelas mapeadas
+        struct stat st;
+        if (fstat(fileno(leitor->arquivo), &st) == 0 && S_ISREG(st.st_mode)) {
+            leitor->fd = fileno(leitor->arquivo);
+            leitor->tamanho_arquivo = (uint64_t)st.st_size;
+        }
+#endif
+        return 0;
+    }
+
+    leitor->formato = TRACE_TEXTO;
+    rewind(leitor->arquivo);
+    return 0;
+}
+
+// Lê o próximo acesso; retorna 1 se leu, 0 no fim do trace e -1 em erro
+int proximoAcesso(LeitorTrace *leitor, AcessoTrace *acesso) {
+    if (leitor->formato == TRACE_BINARIO)
+        return proximoBinario(leitor, acesso);
+    return proximoTexto(leitor, acesso);
+}
+
+// Avança n acessos sem reproduzi-los; retorna quantos foram pulados (menos que n
+// no fim do trace) ou -1 em erro
+int64_t pulaAcessos(LeitorTrace *leitor, int64_t n) {
+    if (leitor->formato == TRACE_BINARIO && leitor->fd >= 0) {
+        // Arquivo mapeado: salta direto para o registro
+        uint64_t restantes = (leitor->tamanho_arquivo - leitor->posicao) / sizeof(RegistroTrace);
+        if ((uint64_t)n > restantes)
+            n = (int64_t)restantes;
+        leitor->posicao += (uint64_t)n * sizeof(RegistroTrace);
+        return n;
+    }
+    AcessoTrace acesso;
+    int64_t pulados = 0;
+    int r = 1;
+    while (pulados < n && (r = proximoAcesso(leitor, &acesso)) == 1)
+        pulados++;
+    return (r < 0) ? -1 : pulados;
+}
+
+// Volta ao primeiro acesso do trace
+int reiniciaTrace(LeitorTrace *leitor) {
+    if (leitor->arquivo == stdin) {
+        fprintf(stderr, "Trace da entrada padrao nao pode ser reiniciado\n");
+        return -1;
+    }
+    leitor->linha = 0;
+    leitor->posicao = (leitor->formato == TRACE_BINARIO) ? sizeof(CabecalhoTrace) : 0;
+    return fseek(leitor->arquivo, (long)leitor->posicao, SEEK_SET);
+}
+
+// Fecha o trace e desfaz o mapeamento
+void fechaTrace(LeitorTrace *leitor) {
+#ifndef _WIN32
+    if (leitor->janela)
+        munmap((void *)leitor->janela, leitor->tamanho_janela);
+#endif
+    if (leitor->arquivo && leitor->arquivo != stdin)
+        fclose(leitor->arquivo);
+    memset(leitor, 0, sizeof(*leitor));
+    leitor->fd = -1;
+}
+
+// Converte trace (texto ou binário) para o formato binário
+int converteTrace(const char *origem, const char *destino) {
+    LeitorTrace leitor;
+    if (abreTrace(&leitor, origem) != 0)
+        return -1;
+    FILE *saida = fopen(destino, "wb");
+    if (!saida) {
+        perror(destino);
+        fechaTrace(&leitor);
+        return -1;
+    }
+
+    CabecalhoTrace cab = {{'P', 'G', 'T', 'R'}, TRACE_VERSAO, 0};
+    fwrite(&cab, sizeof(cab), 1, saida);
+
+    AcessoTrace acesso;
+    int r;
+    while ((r = proximoAcesso(&leitor, &acesso)) == 1) {
+        RegistroTrace reg;
+        memset(&reg, 0, sizeof(reg));
+        reg.endereco = (uint64_t)acesso.endereco;
+        reg.pid = (uint32_t)acesso.pid;
+        reg.op = (uint8_t)acesso.op;
+        fwrite(&reg, sizeof(reg), 1, saida);
+    }
+
+    fechaTrace(&leitor);
+    if (fclose(saida) != 0 || r < 0)
+        return -1;
+    return 0;
+}
+
+// Executa um acesso, criando o processo ou aumentando sua tabela se preciso. O
+// algoritmo já deve estar preparado (preparaTraducao) e o processo achado aqui vai
+// direto para traduzAcesso; retorna -1 se faltou memória ou a tradução falhou
+int reproduzAcesso(Simulador *sim, const AcessoTrace *acesso) {
+    INSTR_INICIO(t_processo);
+    int64_t num_pag = paginaDoEndereco(sim, acesso->endereco);
+    Processo *proc = buscaProcesso(sim, acesso->pid);
+    if (!proc)
+        proc = adicionaProcesso(sim, acesso->pid, num_pag + 1);
+    else if (num_pag >= proc->num_paginas && garantePaginas(sim, proc, num_pag + 1) != 0)
+        proc = NULL;
+    if (!proc) {
+        fprintf(stderr, "Sem memoria para o processo %d\n", acesso->pid);
+        return -1;
+    }
+    INSTR_FIM(FASE_PROCESSO, t_processo);
+
+    int64_t fisico = traduzAcesso(sim, sim->algoritmo, proc, acesso->endereco, acesso->op == 'W');
+    return fisico < 0 ? -1 : 0;
+}
+
+// Decodifica o restante do trace para um vetor
+static int64_t leAcessos(LeitorTrace *leitor, AcessoTrace **acessos) {
+    int64_t capacidade = 0, num_acessos = 0;
+    *acessos = NULL;
+    // Binário: o número de registros sai do tamanho do arquivo
+    if (leitor->formato == TRACE_BINARIO && leitor->tamanho_arquivo > leitor->posicao)
+        capacidade = (int64_t)((leitor->tamanho_arquivo - leitor->posicao) / sizeof(RegistroTrace));
+    if (capacidade > 0 && !(*acessos = malloc((size_t)capacidade * sizeof(AcessoTrace))))
+        capacidade = 0;
+
+    AcessoTrace acesso;
+    int r;
+    while ((r = proximoAcesso(leitor, &acesso)) == 1) {
+        if (num_acessos == capacidade) {
+            int64_t nova_cap = capacidade ? capacidade * 2 : 4096;
+            AcessoTrace *novo = realloc(*acessos, (size_t)nova_cap * sizeof(AcessoTrace));
+            if (!novo) {
+                fprintf(stderr, "Sem memoria para carregar o trace\n");
+                r = -1;
+                break;
+            }
+            *acessos = novo;
+            capacidade = nova_cap;
+        }
+        (*acessos)[num_acessos++] = acesso;
+    }
+
+    if (r < 0) {
+        free(*acessos);
+        *acessos = NULL;
+        return -1;
+    }
+    return num_acessos;
+}
+
+// Reproduz todos os acessos do trace, criando processos e páginas sob demanda
+int64_t executaTrace(Simulador *sim, LeitorTrace *leitor) {
+    // O OPT precisa do trace inteiro para saber o próximo uso de cada página
+    if (sim->algoritmo == ALG_OTIMO) {
+        AcessoTrace *acessos;
+        int64_t num_acessos = leAcessos(leitor, &acessos);
+        if (num_acessos < 0)
+            return -1;
+        int64_t executados = executaAcessos(sim, acessos, num_acessos);
+        free(acessos);
+        return executados;
+    }
+
+    if (preparaTraducao(sim, sim->algoritmo) != 0)
+        return -1;
+    AcessoTrace acesso;
+    int64_t executados = 0;
+    int r;
+    while ((r = proximoAcesso(leitor, &acesso)) == 1) {
+        if (reproduzAcesso(sim, &acesso) != 0)
+            return -1;
+        executados++;
+    }
+    return (r < 0) ? -1 : executados;
+}
+
+// Reproduz acessos já decodificados em memória
+int64_t executaAcessos(Simulador *sim, const AcessoTrace *acessos, int64_t num_acessos) {
+    EstadoOtimo *ot = &sim->memoria.otimo;
+    uint32_t *proximo_uso = NULL;
+    if (sim->algoritmo == ALG_OTIMO) {
+        proximo_uso = calculaProximoUso(sim, acessos, num_acessos);
+        if (!proximo_uso)
+            return -1;
+        ot->proximo_uso = proximo_uso;
+    }
+
+    // O OPT só se prepara com proximo_uso já calculado
+    int64_t executados = preparaTraducao(sim, sim->algoritmo) == 0 ? num_acessos : -1;
+    for (int64_t i = 0; executados >= 0 && i < num_acessos; i++) {
+        ot->acesso_atual = i;
+        if (reproduzAcesso(sim, &acessos[i]) != 0) {
+            executados = -1;
+            break;
+        }
+    }
+
+    if (proximo_uso) {
+        ot->proximo_uso = NULL;
+        free(proximo_uso);
+    }
+    return executados;
+}
+
+// Decodifica o trace inteiro para um vetor (compartilhado entre simulações)
+int64_t carregaTrace(const char *caminho, AcessoTrace **acessos) {
+    LeitorTrace leitor;
+    *acessos = NULL;
+    if (abreTrace(&leitor, caminho) != 0)
+        return -1;
+    int64_t num_acessos = leAcessos(&leitor, acessos);
+    fechaTrace(&leitor);
+    return num_acessos;
+}
@@ -0,0 +1,65 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "estruturas.h"
+
+// Formatos de arquivo de trace
+#define TRACE_TEXTO   0 // Uma linha "pid op endereco" por acesso
+#define TRACE_BINARIO 1 // Cabeçalho + registros de 16 bytes
+
+// Cabeçalho do formato binário
+#define TRACE_MAGICO "PGTR"
+#define TRACE_VERSAO 1
+
+typedef struct
+{
+    char magico[4];     // "PGTR"
+    uint32_t versao;    // TRACE_VERSAO
+    uint64_t reservado; // Zero
+} CabecalhoTrace;
+
+// Registro do formato binário (16 bytes, ordem de bytes da máquina)
+typedef struct
+{
+    uint64_t endereco;     // Endereço virtual
+    uint32_t pid;          // Processo que fez o acesso
+    uint8_t op;            // 'R' (leitura) ou 'W' (escrita)
+    uint8_t reservado[3];  // Zero
+} RegistroTrace;
+
+// Um acesso lido do trace
+typedef struct
+{
+    int pid;      // Processo que fez o acesso
+    char op;      // 'R' (leitura) ou 'W' (escrita)
+    int64_t endereco; // Endereço virtual
+} AcessoTrace;
+
+typedef struct
+{
+    int formato;      // TRACE_TEXTO ou TRACE_BINARIO
+    FILE *arquivo;    // Arquivo aberto (texto ou binário sem mmap)
+    long linha;       // Linha atual do trace texto (para mensagens de erro)
+    // Leitura do binário por janelas mapeadas em memória
+    int fd;                      // Descritor do arquivo (-1 se não mapeado)
+    const unsigned char *janela; // Janela mapeada atualmente
+    uint64_t inicio_janela;      // Deslocamento da janela no arquivo
+    uint64_t tamanho_janela;     // Tamanho da janela mapeada
+    uint64_t tamanho_arquivo;    // Tamanho total do arquivo
+    uint64_t posicao;            // Deslocamento do próximo registro
+} LeitorTrace;
+
+int abreTrace(LeitorTrace *leitor, const char *caminho);
+int proximoAcesso(LeitorTrace *leitor, AcessoTrace *acesso);
+int64_t pulaAcessos(LeitorTrace *leitor, int64_t n);
+int reiniciaTrace(LeitorTrace *leitor);
+void fechaTrace(LeitorTrace *leitor);
+int converteTrace(const char *origem, const char *destino);
+int reproduzAcesso(Simulador *sim, const AcessoTrace *acesso);
+int64_t executaTrace(Simulador *sim, LeitorTrace *leitor);
+int64_t executaAcessos(Simulador *sim, const AcessoTrace *acessos, int64_t num_acessos);
+int64_t carregaTrace(const char *caminho, AcessoTrace **acessos);
+
+#endif
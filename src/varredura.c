@@ -0,0 +1,169 @@
+#include "varredura.h"
+#include "tabela_hash.h"
+#include "algoritmos.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacidade inicial da árvore de Fenwick (posições de tempo)
+#ifndef VARREDURA_CAPACIDADE_INICIAL
+#define VARREDURA_CAPACIDADE_INICIAL (1 << 16)
+#endif
+
+// Árvore de Fenwick sobre as posições de tempo: posição marcada = último
+// acesso de alguma página. A distância de pilha de um acesso é o número de
+// marcas depois do último acesso à mesma página, mais um.
+typedef struct
+{
+    int *arvore;        // Somas parciais (índices 1..capacidade)
+    uint64_t *chave_em; // Página cujo último acesso está na posição (0 = nenhuma)
+    int capacidade;
+    int tempo;          // Última posição usada
+    MapaHash ultimo;    // Página -> posição do último acesso
+} PilhaLRU;
+
+// Soma as marcas nas posições 1..pos
+static int somaAte(const PilhaLRU *pilha, int pos) {
+    int soma = 0;
+    for (; pos > 0; pos -= pos & -pos)
+        soma += pilha->arvore[pos];
+    return soma;
+}
+
+// Soma delta na posição pos
+static void atualiza(PilhaLRU *pilha, int pos, int delta) {
+    for (; pos <= pilha->capacidade; pos += pos & -pos)
+        pilha->arvore[pos] += delta;
+}
+
+// Renumera as posições marcadas em 1..D (mantendo a ordem) e ajusta a capacidade
+static int compacta(PilhaLRU *pilha) {
+    int distintas = 0;
+    for (int pos = 1; pos <= pilha->tempo; pos++) {
+        if (pilha->chave_em[pos]) {
+            uint64_t chave = pilha->chave_em[pos];
+            pilha->chave_em[++distintas] = chave;
+            mapaInsere(&pilha->ultimo, chave, distintas);
+        }
+    }
+
+    // Garante ao menos metade da árvore livre após a compactação
+    int nova_cap = pilha->capacidade;
+    while (nova_cap < 2 * distintas + 2)
+        nova_cap *= 2;
+    if (nova_cap != pilha->capacidade) {
+        int *arvore = realloc(pilha->arvore, (nova_cap + 1) * sizeof(int));
+        uint64_t *chave_em = realloc(pilha->chave_em, (nova_cap + 1) * sizeof(uint64_t));
+        if (arvore)
+            pilha->arvore = arvore;
+        if (chave_em)
+            pilha->chave_em = chave_em;
+        if (!arvore || !chave_em)
+            return -1;
+        pilha->capacidade = nova_cap;
+    }
+    memset(pilha->chave_em + distintas + 1, 0,
+           (pilha->capacidade - distintas) * sizeof(uint64_t));
+
+    // Reconstrói a árvore em O(n): todas as posições 1..D marcadas
+    memset(pilha->arvore, 0, (pilha->capacidade + 1) * sizeof(int));
+    for (int pos = 1; pos <= pilha->capacidade; pos++) {
+        if (pos <= distintas)
+            pilha->arvore[pos] += 1;
+        int pai = pos + (pos & -pos);
+        if (pai <= pilha->capacidade)
+            pilha->arvore[pai] += pilha->arvore[pos];
+    }
+    pilha->tempo = distintas;
+    return 0;
+}
+
+// Soma um acesso com distância d ao histograma
+static int registraDistancia(CurvaFaltas *curva, int d) {
+    if (d >= curva->capacidade) {
+        int nova_cap = curva->capacidade ? curva->capacidade * 2 : 1024;
+        while (nova_cap <= d)
+            nova_cap *= 2;
+        int64_t *novo = realloc(curva->histograma, nova_cap * sizeof(int64_t));
+        if (!novo)
+            return -1;
+        memset(novo + curva->capacidade, 0, (nova_cap - curva->capacidade) * sizeof(int64_t));
+        curva->histograma = novo;
+        curva->capacidade = nova_cap;
+    }
+    curva->histograma[d]++;
+    if (d > curva->max_distancia)
+        curva->max_distancia = d;
+    return 0;
+}
+
+// Calcula o histograma de distâncias de pilha do LRU em uma passada pelo trace
+int calculaCurvaLRU(LeitorTrace *leitor, int tamanho_pagina, CurvaFaltas *curva) {
+    memset(curva, 0, sizeof(*curva));
+    PilhaLRU pilha;
+    memset(&pilha, 0, sizeof(pilha));
+    pilha.capacidade = VARREDURA_CAPACIDADE_INICIAL;
+    pilha.arvore = calloc(pilha.capacidade + 1, sizeof(int));
+    pilha.chave_em = calloc(pilha.capacidade + 1, sizeof(uint64_t));
+    if (!pilha.arvore || !pilha.chave_em || mapaInicializa(&pilha.ultimo, 1024) != 0) {
+        free(pilha.arvore);
+        free(pilha.chave_em);
+        return -1;
+    }
+
+    // Página por shift quando o tamanho é potência de 2; o pid fica acima dos bits da página
+    int bits_desloc = bitsDeslocamento(tamanho_pagina);
+    int bits_pagina = bitsNumeroPagina(tamanho_pagina);
+    int status = 0;
+    AcessoTrace acesso;
+    int r;
+    while ((r = proximoAcesso(leitor, &acesso)) == 1) {
+        if (pilha.tempo == pilha.capacidade && compacta(&pilha) != 0) {
+            status = -1;
+            break;
+        }
+        // Chave = (pid, página) + 1, para que 0 marque posição vazia
+        int64_t pagina = bits_desloc >= 0 ? acesso.endereco >> bits_desloc
+                                          : acesso.endereco / tamanho_pagina;
+        if (bits_pagina > 32 && ((uint64_t)acesso.pid >> (64 - bits_pagina)) != 0) {
+            fprintf(stderr, "Pid %d grande demais para paginas de %d bytes\n", acesso.pid,
+                    tamanho_pagina);
+            status = -1;
+            break;
+        }
+        uint64_t chave = (((uint64_t)(uint32_t)acesso.pid << bits_pagina) | (uint64_t)pagina) + 1;
+        int pos = ++pilha.tempo;
+        int64_t anterior;
+        if (mapaBusca(&pilha.ultimo, chave, &anterior)) {
+            int d = somaAte(&pilha, pos - 1) - somaAte(&pilha, (int)anterior) + 1;
+            atualiza(&pilha, (int)anterior, -1);
+            pilha.chave_em[anterior] = 0;
+            if (registraDistancia(curva, d) != 0) {
+                status = -1;
+                break;
+            }
+        } else {
+            curva->faltas_frias++;
+        }
+        atualiza(&pilha, pos, 1);
+        pilha.chave_em[pos] = chave;
+        if (mapaInsere(&pilha.ultimo, chave, pos) != 0) {
+            status = -1;
+            break;
+        }
+        curva->total_acessos++;
+    }
+    if (r < 0)
+        status = -1;
+
+    free(pilha.arvore);
+    free(pilha.chave_em);
+    mapaLibera(&pilha.ultimo);
+    return status;
+}
+
+// Libera o histograma da curva
+void liberaCurva(CurvaFaltas *curva) {
+    free(curva->histograma);
+    memset(curva, 0, sizeof(*curva));
+}
@@ -0,0 +1,21 @@
+#ifndef VARREDURA_H
+#define VARREDURA_H
+
+#include <stdint.h>
+#include "trace.h"
+
+// Curva de page faults do LRU para todos os números de frames,
+// obtida em uma passada pelas distâncias de pilha (reuso) do trace
+typedef struct
+{
+    int64_t *histograma;  // histograma[d] = acessos com distância de pilha d (d >= 1)
+    int max_distancia;    // Maior distância observada
+    int capacidade;       // Posições alocadas em histograma
+    int64_t faltas_frias; // Primeiro acesso a cada página (distância infinita)
+    int64_t total_acessos;
+} CurvaFaltas;
+
+int calculaCurvaLRU(LeitorTrace *leitor, int tamanho_pagina, CurvaFaltas *curva);
+void liberaCurva(CurvaFaltas *curva);
+
+#endif
@@ -0,0 +1,390 @@
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "../src/estruturas.h"
+#include "../src/algoritmos.h"
+#include "../src/trace.h"
+
+// Cargas sintéticas (todas de um processo só, com 25% de escritas)
+#define CARGA_UNIFORME  0 // Páginas sorteadas com a mesma probabilidade
+#define CARGA_ZIPF      1 // Página de posição k com probabilidade proporcional a 1/k
+#define CARGA_VARREDURA 2 // Todas as páginas em sequência, repetidamente
+#define CARGA_LACO      3 // Laço sobre LACO_PAGINAS páginas
+#define CARGA_FASES     4 // Working set de FASE_PAGINAS páginas que muda NUM_FASES vezes
+#define NUM_CARGAS      5
+
+#define PAGINAS_CARGA 4096 // Páginas distintas das cargas uniforme, Zipf e varredura
+#define LACO_PAGINAS  768  // Entre o menor e o maior número de frames medido
+#define FASE_PAGINAS  200
+#define NUM_FASES     8
+#define ACESSOS_PADRAO 200000
+#define TOLERANCIA_PADRAO 0.3 // Queda de vazão aceita em relação à referência
+#define REPETICOES 5          // Passadas de vazão; vale a mais rápida, a menos perturbada
+
+static const char *nomes_cargas[NUM_CARGAS] = {"uniforme", "zipf", "varredura", "laco", "fases"};
+
+// Números de frames medidos para cada carga e algoritmo
+static const int frames_medidos[] = {64, 256, 1024};
+#define NUM_FRAMES_MEDIDOS ((int)(sizeof(frames_medidos) / sizeof(frames_medidos[0])))
+
+// O OPT só existe na reprodução de traces e não entra na medida por acesso
+#define NUM_ALGORITMOS_MEDIDOS ALG_OTIMO
+
+// Resultado de uma combinação (carga, algoritmo, frames)
+typedef struct
+{
+    int carga;
+    int algoritmo;
+    int frames;
+    int64_t acessos;
+    int64_t page_faults;
+    double acessos_por_seg; // Vazão da reprodução sem medir cada acesso
+    double ns_hit;          // Tempo médio de um hit
+    double ns_falta;        // Tempo médio de um page fault (com a escolha da vítima)
+    long pico_kb;           // Pico de memória residente acrescentado pela simulação
+} ResultadoBenchmark;
+
+// Gerador xorshift64*: a mesma sequência em qualquer plataforma
+static uint64_t proximoAleatorio(uint64_t *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 2685821657736338717ULL;
+}
+
+// Número aleatório em [0, 1)
+static double aleatorioUnitario(uint64_t *estado) {
+    return (proximoAleatorio(estado) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Sorteia a posição de Zipf (s = 1) pela distribuição acumulada
+static int64_t sorteiaZipf(const double *acumulada, int64_t n, uint64_t *estado) {
+    double u = aleatorioUnitario(estado) * acumulada[n - 1];
+    int64_t ini = 0, fim = n - 1;
+    while (ini < fim) {
+        int64_t meio = (ini + fim) / 2;
+        if (acumulada[meio] < u)
+            ini = meio + 1;
+        else
+            fim = meio;
+    }
+    return ini;
+}
+
+// Gera num_acessos acessos da carga; retorna NULL se falta memória
+static AcessoTrace *geraCarga(int carga, int64_t num_acessos) {
+    AcessoTrace *acessos = malloc((size_t)num_acessos * sizeof(AcessoTrace));
+    double *acumulada = NULL;
+    if (acessos && carga == CARGA_ZIPF) {
+        acumulada = malloc(PAGINAS_CARGA * sizeof(double));
+        if (!acumulada) {
+            free(acessos);
+            return NULL;
+        }
+        double soma = 0.0;
+        for (int k = 0; k < PAGINAS_CARGA; k++)
+            acumulada[k] = soma += 1.0 / (k + 1);
+    }
+    if (!acessos)
+        return NULL;
+
+    uint64_t estado = 0x9e3779b97f4a7c15ULL + (uint64_t)carga; // Semente fixa por carga
+    int64_t por_fase = num_acessos / NUM_FASES + 1;
+    for (int64_t i = 0; i < num_acessos; i++) {
+        int64_t pagina;
+        switch (carga) {
+            case CARGA_ZIPF:
+                pagina = sorteiaZipf(acumulada, PAGINAS_CARGA, &estado);
+                break;
+            case CARGA_VARREDURA:
+                pagina = i % PAGINAS_CARGA;
+                break;
+            case CARGA_LACO:
+                pagina = i % LACO_PAGINAS;
+                break;
+            case CARGA_FASES:
+                pagina = (i / por_fase) * FASE_PAGINAS +
+                         (int64_t)(proximoAleatorio(&estado) % FASE_PAGINAS);
+                break;
+            default:
+                pagina = (int64_t)(proximoAleatorio(&estado) % PAGINAS_CARGA);
+                break;
+        }
+        acessos[i].pid = 1;
+        acessos[i].op = (proximoAleatorio(&estado) & 3) == 0 ? 'W' : 'R';
+        acessos[i].endereco = pagina * 4096;
+    }
+    free(acumulada);
+    return acessos;
+}
+
+// Tempo monotônico em nanossegundos
+static double agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Pico de memória residente do processo em KB
+static long picoResidente(void) {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+// Custo de uma leitura do relógio, descontado do tempo de cada acesso
+static double custoRelogio(void) {
+    double inicio = agoraNs();
+    for (int i = 0; i < 10000; i++)
+        agoraNs();
+    return (agoraNs() - inicio) / 10000;
+}
+
+// Mede uma combinação: vazão em passadas sem relógio por acesso e, numa última
+// passada com a memória esvaziada, o tempo de cada hit e de cada falta
+static int simula(const AcessoTrace *acessos, int64_t num_acessos, ResultadoBenchmark *r) {
+    long pico_inicial = picoResidente();
+    Simulador sim;
+    inicializarSimulador(&sim);
+    sim.verbosidade = VERBOSIDADE_SILENCIOSO;
+    sim.algoritmo = r->algoritmo;
+    if (configuraMemoria(&sim, 4096, r->frames * 4096) != 0) {
+        liberarSimulador(&sim);
+        return -1;
+    }
+
+    double melhor = 0.0;
+    for (int rep = 0; rep < REPETICOES; rep++) {
+        double inicio = agoraNs();
+        if (executaAcessos(&sim, acessos, num_acessos) < 0) {
+            liberarSimulador(&sim);
+            return -1;
+        }
+        double decorrido = agoraNs() - inicio;
+        if (rep == 0 || decorrido < melhor)
+            melhor = decorrido;
+        r->acessos = sim.total_acessos;
+        r->page_faults = sim.page_faults;
+        reinicializarMemoria(&sim);
+    }
+    r->acessos_por_seg = melhor > 0 ? num_acessos / (melhor / 1e9) : 0.0;
+
+    double custo = custoRelogio();
+    double soma_hit = 0.0, soma_falta = 0.0;
+    if (preparaTraducao(&sim, sim.algoritmo) != 0) {
+        liberarSimulador(&sim);
+        return -1;
+    }
+    for (int64_t i = 0; i < num_acessos; i++) {
+        int64_t faltas = sim.page_faults;
+        double t = agoraNs();
+        reproduzAcesso(&sim, &acessos[i]);
+        double d = agoraNs() - t - custo;
+        if (sim.page_faults != faltas)
+            soma_falta += d;
+        else
+            soma_hit += d;
+    }
+    int64_t hits = sim.total_acessos - sim.page_faults;
+    r->ns_hit = hits > 0 && soma_hit > 0 ? soma_hit / hits : 0.0;
+    r->ns_falta = sim.page_faults > 0 && soma_falta > 0 ? soma_falta / sim.page_faults : 0.0;
+    r->pico_kb = picoResidente() - pico_inicial;
+    liberarSimulador(&sim);
+    return 0;
+}
+
+// Mede a combinação num processo filho, para o pico de memória de uma não somar ao das outras
+static int mede(const AcessoTrace *acessos, int64_t num_acessos, ResultadoBenchmark *r) {
+    int canal[2];
+    if (pipe(canal) != 0)
+        return -1;
+    pid_t filho = fork();
+    if (filho < 0) {
+        close(canal[0]);
+        close(canal[1]);
+        return -1;
+    }
+    if (filho == 0) {
+        close(canal[0]);
+        int ok = simula(acessos, num_acessos, r) == 0 &&
+                 write(canal[1], r, sizeof(*r)) == (ssize_t)sizeof(*r);
+        _exit(ok ? 0 : 1);
+    }
+    close(canal[1]);
+    ssize_t lidos = read(canal[0], r, sizeof(*r));
+    close(canal[0]);
+    int status;
+    waitpid(filho, &status, 0);
+    return lidos == (ssize_t)sizeof(*r) && WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+// Converte nome da carga no valor CARGA_*; -1 se desconhecido
+static int cargaPorNome(const char *nome) {
+    for (int c = 0; c < NUM_CARGAS; c++) {
+        if (strcmp(nomes_cargas[c], nome) == 0)
+            return c;
+    }
+    return -1;
+}
+
+// Grava os resultados em CSV (o mesmo formato lido por leReferencia)
+static void escreveResultados(FILE *saida, const ResultadoBenchmark *res, int n) {
+    fprintf(saida, "carga,algoritmo,frames,acessos,page_faults,acessos_por_seg,ns_hit,ns_falta,"
+                   "pico_kb\n");
+    for (int i = 0; i < n; i++)
+        fprintf(saida, "%s,%s,%d,%lld,%lld,%.0f,%.1f,%.1f,%ld\n", nomes_cargas[res[i].carga],
+                nomeAlgoritmo(res[i].algoritmo), res[i].frames, (long long)res[i].acessos,
+                (long long)res[i].page_faults, res[i].acessos_por_seg, res[i].ns_hit,
+                res[i].ns_falta, res[i].pico_kb);
+}
+
+// Lê resultados gravados por escreveResultados; retorna quantos ou -1 em erro
+static int leReferencia(const char *caminho, ResultadoBenchmark *ref, int max) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        fprintf(stderr, "Erro ao abrir a referencia %s\n", caminho);
+        return -1;
+    }
+    char linha[256], carga[32], algoritmo[32];
+    int n = 0;
+    fgets(linha, sizeof(linha), arquivo); // Cabeçalho
+    while (n < max && fgets(linha, sizeof(linha), arquivo)) {
+        ResultadoBenchmark *r = &ref[n];
+        long long acessos, faltas;
+        if (sscanf(linha, "%31[^,],%31[^,],%d,%lld,%lld,%lf,%lf,%lf,%ld", carga, algoritmo,
+                   &r->frames, &acessos, &faltas, &r->acessos_por_seg, &r->ns_hit, &r->ns_falta,
+                   &r->pico_kb) != 9)
+            continue;
+        r->carga = cargaPorNome(carga);
+        r->algoritmo = algoritmoPorNome(algoritmo);
+        r->acessos = acessos;
+        r->page_faults = faltas;
+        if (r->carga >= 0 && r->algoritmo >= 0)
+            n++;
+    }
+    fclose(arquivo);
+    return n;
+}
+
+// Compara com a referência: page faults têm de ser iguais (a simulação é determinística)
+// e a vazão de cada algoritmo, em média geométrica das razões sobre suas combinações,
+// não pode cair mais que a tolerância. Retorna o número de problemas
+static int comparaReferencia(const ResultadoBenchmark *res, int n, const ResultadoBenchmark *ref,
+                             int n_ref, double tolerancia) {
+    int problemas = 0;
+    double soma_log[NUM_ALGORITMOS_MEDIDOS] = {0};
+    int pares[NUM_ALGORITMOS_MEDIDOS] = {0};
+    for (int i = 0; i < n; i++) {
+        const ResultadoBenchmark *r = &res[i];
+        for (int j = 0; j < n_ref; j++) {
+            const ResultadoBenchmark *b = &ref[j];
+            if (b->carga != r->carga || b->algoritmo != r->algoritmo || b->frames != r->frames ||
+                b->acessos != r->acessos)
+                continue;
+            if (b->page_faults != r->page_faults) {
+                printf("MUDOU     %-9s %-15s %5d frames: %lld page faults (referencia %lld)\n",
+                       nomes_cargas[r->carga], nomeAlgoritmo(r->algoritmo), r->frames,
+                       (long long)r->page_faults, (long long)b->page_faults);
+                problemas++;
+            }
+            if (r->acessos_por_seg > 0 && b->acessos_por_seg > 0) {
+                soma_log[r->algoritmo] += log(r->acessos_por_seg / b->acessos_por_seg);
+                pares[r->algoritmo]++;
+            }
+            break;
+        }
+    }
+    for (int a = 0; a < NUM_ALGORITMOS_MEDIDOS; a++) {
+        if (pares[a] == 0)
+            continue;
+        double razao = exp(soma_log[a] / pares[a]);
+        int regressao = razao < 1.0 - tolerancia;
+        printf("%-9s %-15s vazao %.2fx a da referencia (%d combinacoes)\n",
+               regressao ? "REGRESSAO" : "ok", nomeAlgoritmo(a), razao, pares[a]);
+        problemas += regressao;
+    }
+    return problemas;
+}
+
+int main(int argc, char *argv[]) {
+    int64_t num_acessos = ACESSOS_PADRAO;
+    const char *grava = NULL, *compara = NULL;
+    double tolerancia = TOLERANCIA_PADRAO;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--acessos") == 0)
+            num_acessos = atoll(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--grava") == 0)
+            grava = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--compara") == 0)
+            compara = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--tolerancia") == 0)
+            tolerancia = atof(argv[++i]);
+        else {
+            fprintf(stderr, "Uso: %s [--acessos N] [--grava ARQ] [--compara ARQ] "
+                            "[--tolerancia F]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (num_acessos < 1 || tolerancia < 0.0 || tolerancia >= 1.0) {
+        fprintf(stderr, "Parametros invalidos\n");
+        return 1;
+    }
+
+    enum { MAX_RESULTADOS = NUM_CARGAS * NUM_ALGORITMOS_MEDIDOS * NUM_FRAMES_MEDIDOS };
+    ResultadoBenchmark resultados[MAX_RESULTADOS];
+    int n = 0;
+    for (int c = 0; c < NUM_CARGAS; c++) {
+        AcessoTrace *acessos = geraCarga(c, num_acessos);
+        if (!acessos) {
+            fprintf(stderr, "Sem memoria para a carga %s\n", nomes_cargas[c]);
+            return 2;
+        }
+        for (int a = 0; a < NUM_ALGORITMOS_MEDIDOS; a++) {
+            for (int f = 0; f < NUM_FRAMES_MEDIDOS; f++) {
+                ResultadoBenchmark *r = &resultados[n];
+                memset(r, 0, sizeof(*r));
+                r->carga = c;
+                r->algoritmo = a;
+                r->frames = frames_medidos[f];
+                if (mede(acessos, num_acessos, r) != 0) {
+                    fprintf(stderr, "Falha em %s, %s, %d frames\n", nomes_cargas[c],
+                            nomeAlgoritmo(a), frames_medidos[f]);
+                    free(acessos);
+                    return 2;
+                }
+                n++;
+            }
+        }
+        free(acessos);
+    }
+
+    escreveResultados(stdout, resultados, n);
+    if (grava) {
+        FILE *saida = fopen(grava, "w");
+        if (!saida) {
+            fprintf(stderr, "Erro ao criar %s\n", grava);
+            return 2;
+        }
+        escreveResultados(saida, resultados, n);
+        fclose(saida);
+    }
+    if (compara) {
+        ResultadoBenchmark referencia[MAX_RESULTADOS];
+        int n_ref = leReferencia(compara, referencia, MAX_RESULTADOS);
+        if (n_ref < 0)
+            return 2;
+        int problemas = comparaReferencia(resultados, n, referencia, n_ref, tolerancia);
+        printf("%d problema(s) em relacao a %s\n", problemas, compara);
+        return problemas ? 3 : 0;
+    }
+    return 0;
+}
@@ -1,150 +1,240 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <locale.h>
-#include "../src./estruturas.h"
-#include "../src./algoritmos.h"
-
-// Inicializa todos os parâmetros do simulador com valores padrões
-void inicializarSimulador(Simulador *sim) {
-    sim->tempo_atual = 0;                             // Contador global de tempo
-    sim->tamanho_pagina = 4096;                       // Tamanho fixo de cada página (4 KB)
-    sim->tamanho_memoria_fisica = 16384;              // Total de memória física (16 KB)
-    sim->num_processos = 0;                           // Sem processos inicialmente
-    sim->processos = NULL;
-
-    // Calcula número de frames e aloca estruturas
-    sim->memoria.num_frames = sim->tamanho_memoria_fisica / sim->tamanho_pagina;
-    sim->memoria.frames = calloc(sim->memoria.num_frames, sizeof(int));
-    sim->memoria.tempo_carga = calloc(sim->memoria.num_frames, sizeof(int));
-    for (int i = 0; i < sim->memoria.num_frames; i++)
-        sim->memoria.frames[i] = -1;                  // Marca todos os frames como livres
-
-    sim->total_acessos = 0;                           // Contador de acessos a memória
-    sim->page_faults   = 0;                           // Contador de page faults
-    sim->algoritmo     = 0;                           // Algoritmo padrão = FIFO
+#include "../src/estruturas.h"
+#include "../src/algoritmos.h"
+#include "../src/instantaneo.h"
+#include "../src/trace.h"
+
+// Verificações de comportamento sem interação: page faults conhecidos dos algoritmos
+// clássicos, gravações de páginas modificadas, limites do OPT e estado gravado e
+// restaurado igual à execução direta. Sai com código 1 se alguma falhar
+
+#define PAGINA 4096
+#define ARQUIVO_ESTADO "teste_basico.pgs"
+
+static int falhas = 0;
+
+static void verifica(int condicao, const char *descricao) {
+    if (!condicao) {
+        printf("FALHOU: %s\n", descricao);
+        falhas++;
+    }
 }
 
-// Libera toda a memória alocada dinâmicamente pelo simulador
-void liberarSimulador(Simulador *sim) {
-    for (int i = 0; i < sim->num_processos; i++)
-        free(sim->processos[i].tabela_paginas);       // Remove tabelas de páginas
-    free(sim->processos);                             // Remove vetor de processos
-    free(sim->memoria.frames);                        // Remove vetor de frames
-    free(sim->memoria.tempo_carga);                   // Remove vetor de tempo de carga
+// Simulador silencioso com frames de 4 KB
+static int criaSimulador(Simulador *sim, int algoritmo, int frames) {
+    inicializarSimulador(sim);
+    sim->verbosidade = VERBOSIDADE_SILENCIOSO;
+    sim->algoritmo = algoritmo;
+    return configuraMemoria(sim, PAGINA, frames * PAGINA);
 }
 
-// Desenha o cabeçalho na tela mostrando configurações atuais
-void drawHeader(const Simulador *sim) {
-    system("cls || clear");                         // Limpa a tela (Windows/Linux)
-    const char *algoritmos[] = {"FIFO", "LRU"};
-
-    printf("===== SIMULADOR DE PAGINACAO =====\n");
-    printf("Tamanho da pagina: %d bytes (%d KB)\n",
-           sim->tamanho_pagina, sim->tamanho_pagina / 1024);
-    printf("Tamanho da memoria fisica: %d bytes (%d KB)\n",
-           sim->tamanho_memoria_fisica, sim->tamanho_memoria_fisica / 1024);
-    printf("Numero de frames: %d\n", sim->memoria.num_frames);
-    printf("Algoritmo de substituicao: %s\n\n",
-           algoritmos[sim->algoritmo]);
+// Reproduz as páginas (processo 1; 'W' nas posições marcadas em escritas, se dado)
+// como um trace e devolve os page faults, ou -1 em erro
+static int64_t faltasDaSequencia(int algoritmo, int frames, const int *paginas, int n,
+                                 const char *escritas, int64_t *gravacoes) {
+    Simulador sim;
+    AcessoTrace *acessos = malloc(n * sizeof(AcessoTrace));
+    if (!acessos || criaSimulador(&sim, algoritmo, frames) != 0) {
+        free(acessos);
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        acessos[i].pid = 1;
+        acessos[i].op = (escritas && escritas[i] == 'W') ? 'W' : 'R';
+        acessos[i].endereco = (int64_t)paginas[i] * PAGINA;
+    }
+    int64_t faltas = executaAcessos(&sim, acessos, n) == n ? sim.page_faults : -1;
+    if (gravacoes)
+        *gravacoes = sim.escritas_disco;
+    liberarSimulador(&sim);
+    free(acessos);
+    return faltas;
 }
 
-// Menu para o usuário alterar parâmetros do simulador
-void menuInsercao(Simulador *sim) {
-    int opc;
-    do {
-        drawHeader(sim);
-        printf("===== MENU DE PARAMETROS =====\n");
-        printf("1. Definir tamanho da pagina\n");
-        printf("2. Definir tamanho da memoria fisica\n");
-        printf("3. Escolher algoritmo (0=FIFO, 1=LRU, ...)\n");
-        printf("0. Voltar ao menu principal\n");
-        printf("Escolha uma opcao: ");
-        scanf("%d", &opc);
-        switch (opc) {
-            case 1:
-                printf("Novo tamanho da pagina (bytes): ");
-                scanf("%d", &sim->tamanho_pagina);
-                break;
-            case 2:
-                printf("Novo tamanho da memoria fisica (bytes): ");
-                scanf("%d", &sim->tamanho_memoria_fisica);
-                break;
-            case 3:
-                printf("Escolha o algoritmo: ");
-                scanf("%d", &sim->algoritmo);
-                break;
+// Sequência de referência dos livros-texto e a da anomalia de Belady (o FIFO faz mais
+// faltas com 4 frames que com 3). Os valores vêm da simulação à mão de cada política
+static void testaSequenciasConhecidas(void) {
+    static const int classica[] = {7, 0, 1, 2, 0, 3, 0, 4, 2, 3, 0, 3, 2, 1, 2, 0, 1, 7, 0, 1};
+    static const int belady[] = {1, 2, 3, 4, 1, 2, 5, 1, 2, 3, 4, 5};
+    static const int algoritmos[] = {ALG_FIFO, ALG_LRU, ALG_CLOCK, ALG_SEGUNDA_CHANCE, ALG_OTIMO};
+    // Faltas esperadas por algoritmo (na ordem acima) com 3 e com 4 frames
+    static const int64_t esperadas_classica[2][5] = {{15, 12, 14, 14, 9}, {10, 8, 9, 9, 8}};
+    static const int64_t esperadas_belady[2][5] = {{9, 10, 9, 9, 7}, {10, 8, 10, 10, 6}};
+
+    for (int f = 0; f < 2; f++) {
+        for (int a = 0; a < 5; a++) {
+            char descricao[96];
+            int64_t faltas = faltasDaSequencia(algoritmos[a], 3 + f, classica, 20, NULL, NULL);
+            snprintf(descricao, sizeof(descricao), "%s com %d frames na sequencia classica: "
+                     "%lld faltas", nomeAlgoritmo(algoritmos[a]), 3 + f, (long long)faltas);
+            verifica(faltas == esperadas_classica[f][a], descricao);
+            faltas = faltasDaSequencia(algoritmos[a], 3 + f, belady, 12, NULL, NULL);
+            snprintf(descricao, sizeof(descricao), "%s com %d frames na sequencia de Belady: "
+                     "%lld faltas", nomeAlgoritmo(algoritmos[a]), 3 + f, (long long)faltas);
+            verifica(faltas == esperadas_belady[f][a], descricao);
         }
-        // Recalcula frames e realoca vetores após alterações
-        sim->memoria.num_frames = sim->tamanho_memoria_fisica / sim->tamanho_pagina;
-        free(sim->memoria.frames);
-        free(sim->memoria.tempo_carga);
-        sim->memoria.frames = calloc(sim->memoria.num_frames, sizeof(int));
-        sim->memoria.tempo_carga = calloc(sim->memoria.num_frames, sizeof(int));
-        for (int i = 0; i < sim->memoria.num_frames; i++)
-            sim->memoria.frames[i] = -1;
-    } while (opc != 0);
+    }
 }
 
-int main(void) {
-    setlocale(LC_ALL, "");                            // Configura internacionalização
+// A sequência de teste original (16 KB, processo de 8 páginas), páginas 0 1 1 2 1 3 0 1 4:
+// endereços físicos de cada acesso com FIFO e LRU, que só diferem na vítima do último
+// (a página 0, no frame 0, e a 2, no frame 2)
+static void testaSequenciaOriginal(void) {
+    static const int64_t acessos[] = {150, 4150, 8150, 12150, 4150, 16150, 150, 8150, 20150};
+    static const int64_t fisicos_fifo[] = {150, 4150, 8150, 12150, 4150, 16150, 150, 8150, 3766};
+    static const int64_t fisicos_lru[] = {150, 4150, 8150, 12150, 4150, 16150, 150, 8150, 11958};
+    for (int a = ALG_FIFO; a <= ALG_LRU; a++) {
+        const int64_t *esperados = (a == ALG_FIFO) ? fisicos_fifo : fisicos_lru;
+        Simulador sim;
+        criaSimulador(&sim, a, 4);
+        adicionaProcesso(&sim, 1, 8);
+        for (int i = 0; i < 9; i++) {
+            char descricao[96];
+            int64_t fisico = traduzEndereco(&sim, 1, acessos[i]);
+            snprintf(descricao, sizeof(descricao), "%s: acesso %d em %lld (esperado %lld)",
+                     nomeAlgoritmo(a), i + 1, (long long)fisico, (long long)esperados[i]);
+            verifica(fisico == esperados[i], descricao);
+        }
+        verifica(sim.page_faults == 5, "sequencia original com 5 faltas");
+        verifica(traduzEndereco(&sim, 1, 8 * PAGINA) == -1, "endereco fora do processo");
+        verifica(traduzEndereco(&sim, 2, 0) == -1, "processo inexistente");
+        liberarSimulador(&sim);
+    }
+}
 
-    Simulador sim;
-    inicializarSimulador(&sim);
-
-    // Configuração de exemplo: 1 processo com 8 páginas
-    sim.num_processos = 1;
-    sim.processos = malloc(sizeof(Processo));
-    sim.processos[0].pid = 1;
-    sim.processos[0].num_paginas = 8;
-    sim.processos[0].tabela_paginas = calloc(8, sizeof(Pagina));
-
-    int escolha;
-    do {
-        drawHeader(&sim);
-        printf("===== MENU PRINCIPAL =====\n");
-        printf("1. Inserir parametros\n");
-        printf("2. Executar simulacao\n");
-        printf("0. Sair\n");
-        printf("Escolha uma opcao: ");
-        scanf("%d", &escolha);
-
-        switch (escolha) {
-            case 1:
-                menuInsercao(&sim);
-                break;
-
-            case 2: {
-                drawHeader(&sim);
-                printf("======== INICIO DA SIMULACAO ========\n\n");
-
-                // Vetor de acessos de teste (teste misto de faults e hits)
-                int acessos[] = {150, 4150, 8150, 12150, 4150,
-                                 16150, 150, 8150, 20150};
-                int n = sizeof(acessos) / sizeof(*acessos);
-
-                // Executa tradução para cada endereço virtual
-                for (int i = 0; i < n; i++) {
-                    int endereco_virtual = acessos[i];
-                    int endereco_fisico = traduzEndereco(&sim, 1, endereco_virtual);
-                    printf("Acesso %2d: Endereco virtual = %5d -> Endereco fisico = %5d\n",
-                           i + 1, endereco_virtual, endereco_fisico);
-                }
-
-                // Exibe estatísticas ao final da simulação
-                printf("\n======== ESTATISTICAS DA SIMULACAO ========\n");
-                printf("Total de acessos a memoria: %d\n", sim.total_acessos);
-                printf("Total de page faults: %d\n", sim.page_faults);
-                double taxa = 100.0 * sim.page_faults / sim.total_acessos;
-                printf("Taxa de page faults: %.2f%%\n\n", taxa);
-                printf("Algoritmo: FIFO\n");
-
-                printf("\nPressione ENTER para continuar...");
-                getchar(); getchar();
-            } break;
+// Só a página modificada que sai custa gravação: com 2 frames, 0W 1R 2R 3R 0R expulsa
+// 0 (modificada), 1 e 2 (limpas)
+static void testaGravacoes(void) {
+    static const int paginas[] = {0, 1, 2, 3, 0};
+    int64_t gravacoes = -1;
+    int64_t faltas = faltasDaSequencia(ALG_FIFO, 2, paginas, 5, "WRRRR", &gravacoes);
+    verifica(faltas == 5, "faltas da sequencia com escrita");
+    verifica(gravacoes == 1, "uma gravacao para a unica pagina modificada expulsa");
+}
+
+// Trace pseudoaleatório reproduzível (xorshift64*) de dois processos, 25% de escritas
+static void geraTrace(AcessoTrace *acessos, int n, int paginas) {
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < n; i++) {
+        estado ^= estado >> 12;
+        estado ^= estado << 25;
+        estado ^= estado >> 27;
+        uint64_t x = estado * 0x2545F4914F6CDD1DULL;
+        // Metade dos acessos concentrada num quarto das páginas, para haver hits
+        int pagina = (int)((x >> 8) % (uint64_t)((x & 1) ? paginas : paginas / 4));
+        acessos[i].pid = 1 + (int)((x >> 40) & 1);
+        acessos[i].op = ((x >> 44) & 3) == 0 ? 'W' : 'R';
+        acessos[i].endereco = (int64_t)pagina * PAGINA + (int64_t)((x >> 20) % PAGINA);
+    }
+}
+
+// Nenhum algoritmo faz menos faltas que o OPT, e com frames para todas as páginas só
+// há as faltas compulsórias
+static void testaLimites(void) {
+    enum { N = 20000, PAGINAS = 64, FRAMES = 16 };
+    AcessoTrace *acessos = malloc(N * sizeof(AcessoTrace));
+    if (!acessos)
+        return;
+    geraTrace(acessos, N, PAGINAS);
+    int64_t otimo = -1;
+    for (int a = NUM_ALGORITMOS - 1; a >= 0; a--) {
+        Simulador sim;
+        char descricao[96];
+        criaSimulador(&sim, a, FRAMES);
+        verifica(executaAcessos(&sim, acessos, N) == N, "trace aleatorio reproduzido");
+        if (a == ALG_OTIMO)
+            otimo = sim.page_faults;
+        snprintf(descricao, sizeof(descricao), "%s com %lld faltas, menos que o OPT (%lld)",
+                 nomeAlgoritmo(a), (long long)sim.page_faults, (long long)otimo);
+        verifica(sim.page_faults >= otimo, descricao);
+        liberarSimulador(&sim);
+
+        criaSimulador(&sim, a, 2 * PAGINAS);
+        executaAcessos(&sim, acessos, N);
+        snprintf(descricao, sizeof(descricao), "%s sem substituicao: %lld faltas",
+                 nomeAlgoritmo(a), (long long)sim.page_faults);
+        verifica(sim.page_faults == 2 * PAGINAS && sim.escritas_disco == 0, descricao);
+        liberarSimulador(&sim);
+    }
+    free(acessos);
+}
+
+// Traduz os acessos [inicio, fim) guardando os endereços físicos
+static int traduzTrecho(Simulador *sim, const AcessoTrace *acessos, int inicio, int fim,
+                        int64_t *fisicos) {
+    for (int i = inicio; i < fim; i++) {
+        fisicos[i] = traduzEnderecoOp(sim, acessos[i].pid, acessos[i].endereco, acessos[i].op);
+        if (fisicos[i] < 0)
+            return -1;
+    }
+    return 0;
+}
+
+// Gravar o estado no meio e continuar a partir dele dá os mesmos endereços físicos e
+// contadores que a execução direta
+static void testaEstadoGravado(void) {
+    enum { N = 20000, PAGINAS = 64, FRAMES = 16 };
+    AcessoTrace *acessos = malloc(N * sizeof(AcessoTrace));
+    int64_t *direto = malloc(N * sizeof(int64_t));
+    int64_t *retomado = malloc(N * sizeof(int64_t));
+    if (!acessos || !direto || !retomado) {
+        free(acessos);
+        free(direto);
+        free(retomado);
+        return;
+    }
+    geraTrace(acessos, N, PAGINAS);
+    for (int a = 0; a < ALG_OTIMO; a++) {
+        Simulador sim, parte, restaurado;
+        char descricao[96];
+        criaSimulador(&sim, a, FRAMES);
+        criaSimulador(&parte, a, FRAMES);
+        for (int pid = 1; pid <= 2; pid++) {
+            adicionaProcesso(&sim, pid, PAGINAS);
+            adicionaProcesso(&parte, pid, PAGINAS);
+        }
+        verifica(traduzTrecho(&sim, acessos, 0, N, direto) == 0, "execucao direta");
+
+        int64_t posicao = -1;
+        int ok = traduzTrecho(&parte, acessos, 0, N / 2, retomado) == 0 &&
+                 salvaInstantaneo(&parte, ARQUIVO_ESTADO, N / 2) == 0;
+        liberarSimulador(&parte);
+        inicializarSimulador(&restaurado);
+        ok = ok && restauraInstantaneo(&restaurado, ARQUIVO_ESTADO, &posicao) == 0;
+        snprintf(descricao, sizeof(descricao), "%s: gravar e restaurar o estado",
+                 nomeAlgoritmo(a));
+        verifica(ok && posicao == N / 2, descricao);
+        if (ok) {
+            traduzTrecho(&restaurado, acessos, N / 2, N, retomado);
+            snprintf(descricao, sizeof(descricao), "%s: restaurado igual a execucao direta",
+                     nomeAlgoritmo(a));
+            verifica(memcmp(direto, retomado, N * sizeof(int64_t)) == 0 &&
+                         restaurado.page_faults == sim.page_faults &&
+                         restaurado.escritas_disco == sim.escritas_disco &&
+                         restaurado.total_acessos == sim.total_acessos,
+                     descricao);
         }
-    } while (escolha != 0);
+        liberarSimulador(&restaurado);
+        liberarSimulador(&sim);
+    }
+    remove(ARQUIVO_ESTADO);
+    free(acessos);
+    free(direto);
+    free(retomado);
+}
 
-    liberarSimulador(&sim);                            // Libera todos os recursos
+int main(void) {
+    testaSequenciasConhecidas();
+    testaSequenciaOriginal();
+    testaGravacoes();
+    testaLimites();
+    testaEstadoGravado();
+    if (falhas) {
+        printf("%d verificacoes falharam\n", falhas);
+        return 1;
+    }
+    printf("Teste basico: todas as verificacoes passaram\n");
     return 0;
 }
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "../src/biblioteca.h"
+
+// Teste da interface de biblioteca: um lote com resultado conhecido acesso a acesso.
+// Sai com código 1 se alguma verificação falhar
+
+#define PAGINA 4096
+
+static int falhas = 0;
+
+static void verifica(int condicao, const char *descricao) {
+    if (!condicao) {
+        printf("FALHOU: %s\n", descricao);
+        falhas++;
+    }
+}
+
+// FIFO com 3 frames, TLB L1 de uma entrada e L2 de quatro. Páginas e operações:
+//   0R falta | 0W hit L1 | 1R falta (tira 0 da L1) | 0R hit L2 | 2R falta
+//   3R falta, expulsa 0 modificada (gravação) | 0R falta, expulsa 1 limpa
+static void testaLote(void) {
+    ParametrosSimulador p = {PAGINA, 3 * PAGINA, "fifo", NULL, 1, 1, NULL, 1, 4};
+    SimuladorPaginacao *s = simCria(&p);
+    verifica(s != NULL, "simCria com FIFO e TLB de dois niveis");
+    if (!s)
+        return;
+    verifica(simAdicionaProcesso(s, 1, 16 * PAGINA) == 0, "simAdicionaProcesso");
+    verifica(simAdicionaProcesso(s, 1, PAGINA) != 0, "pid repetido e recusado");
+
+    static const int64_t paginas[] = {0, 0, 1, 0, 2, 3, 0};
+    static const char ops[] = {'R', 'W', 'R', 'R', 'R', 'R', 'R'};
+    static const uint8_t esperados[] = {SIM_FALTA, SIM_TLB, SIM_FALTA, SIM_TLB, SIM_FALTA,
+                                        SIM_FALTA | SIM_GRAVOU, SIM_FALTA};
+    static const int64_t frames[] = {0, 0, 1, 0, 2, 0, 1};
+    enum { N = sizeof(paginas) / sizeof(paginas[0]) };
+    int pids[N];
+    int64_t enderecos[N], fisicos[N];
+    uint8_t resultados[N];
+    for (int i = 0; i < N; i++) {
+        pids[i] = 1;
+        enderecos[i] = paginas[i] * PAGINA + 7;
+    }
+
+    verifica(simTraduzLote(s, pids, enderecos, ops, N, fisicos, resultados) == N,
+             "lote traduzido inteiro");
+    for (int i = 0; i < N; i++) {
+        char descricao[64];
+        snprintf(descricao, sizeof(descricao), "bits do acesso %d", i);
+        verifica(resultados[i] == esperados[i], descricao);
+        snprintf(descricao, sizeof(descricao), "endereco fisico do acesso %d", i);
+        verifica(fisicos[i] == frames[i] * PAGINA + 7, descricao);
+    }
+
+    ContadoresSimulador c;
+    simContadores(s, &c);
+    verifica(c.acessos == N, "contador de acessos");
+    verifica(c.faltas == 5, "contador de faltas");
+    verifica(c.escritas_disco == 1, "contador de gravacoes");
+    verifica(c.hits_tlb == 2, "hits da TLB somam L1 e L2");
+    verifica(c.misses_tlb == 5, "misses da TLB contam os que passaram pela L2");
+
+    // O acesso inválido interrompe o lote sem ser simulado
+    int pid_ruim[] = {1, 2};
+    int64_t end_ruim[] = {0, 0};
+    verifica(simTraduzLote(s, pid_ruim, end_ruim, "RR", 2, NULL, NULL) == 1,
+             "processo desconhecido para o lote");
+    int64_t fora[] = {16 * PAGINA};
+    verifica(simTraduzLote(s, pids, fora, "R", 1, NULL, NULL) == 0,
+             "endereco fora do espaco para o lote");
+    verifica(simTraduzLote(s, pids, enderecos, "X", 1, NULL, NULL) == 0,
+             "operacao invalida para o lote");
+    simContadores(s, &c);
+    verifica(c.acessos == N + 1, "acessos invalidos nao contam");
+
+    verifica(simRemoveProcesso(s, 1) == 0, "simRemoveProcesso");
+    verifica(simTraduzLote(s, pids, enderecos, ops, 1, NULL, NULL) == 0,
+             "processo removido nao traduz");
+    simDestroi(s);
+}
+
+static void testaParametrosInvalidos(void) {
+    ParametrosSimulador opt = {0, 0, "opt", NULL, 0, 0, NULL, 0, 0};
+    verifica(simCria(&opt) == NULL, "OPT recusado sem trace");
+    ParametrosSimulador algoritmo = {0, 0, "nenhum", NULL, 0, 0, NULL, 0, 0};
+    verifica(simCria(&algoritmo) == NULL, "algoritmo desconhecido recusado");
+    ParametrosSimulador tabela = {0, 0, NULL, "nenhuma", 0, 0, NULL, 0, 0};
+    verifica(simCria(&tabela) == NULL, "tabela desconhecida recusada");
+
+    SimuladorPaginacao *s = simCria(NULL);
+    verifica(s != NULL, "simCria com os padroes");
+    simDestroi(s);
+}
+
+int main(void) {
+    testaLote();
+    testaParametrosInvalidos();
+    if (falhas) {
+        printf("%d verificacoes falharam\n", falhas);
+        return 1;
+    }
+    printf("Biblioteca: todas as verificacoes passaram\n");
+    return 0;
+}